@@ -7,8 +7,16 @@
 #ifndef GOC_COLLECTION_BITSET_UTILS_H
 #define GOC_COLLECTION_BITSET_UTILS_H
 
-#include <vector>
+#include <algorithm>
+#include <array>
 #include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#include "goc/exception/exception_utils.h"
+#include "goc/graph/vertex.h"
 #include "goc/lib/json.hpp"
 
 namespace goc
@@ -56,6 +64,189 @@ inline bool is_subset(const std::bitset<N>& b1, const std::bitset<N>& b2)
 {
 	return (b1 & b2) == b1;
 }
+
+// This class represents a set of vertices as a bitset of 64 bit words.
+// - If W > 0, the set has W words (vertices {0, ..., 64*W-1}) stored inside the object, so it can be copied and kept
+//	 in labels without allocating memory.
+// - If W == 0, the words are allocated dynamically, and they grow as vertices are inserted.
+// Operations between dynamic sets of different sizes consider the missing words as empty.
+// Precondition (W > 0): vertices are in {0, ..., 64*W-1}.
+template<int W=0>
+class VertexSet
+{
+public:
+	// Creates an empty set.
+	VertexSet() : words_()
+	{ }
+	
+	// Creates a set with the vertices given.
+	VertexSet(std::initializer_list<Vertex> vertices) : VertexSet()
+	{
+		for (Vertex v: vertices) Insert(v);
+	}
+	
+	// Creates a set with the vertices of s.
+	// Precondition (W > 0): the vertices of s are in {0, ..., 64*W-1} (it fails otherwise).
+	template<int W2>
+	explicit VertexSet(const VertexSet<W2>& s) : VertexSet()
+	{
+		Resize(s.WordCount());
+		for (int i = 0; i < std::min(WordCount(), s.WordCount()); ++i) words_[i] = s.Word(i);
+		for (int i = WordCount(); i < s.WordCount(); ++i)
+			if (s.Word(i) != 0) fail("The vertex set does not have enough words for the vertices.");
+	}
+	
+	// Adds v to the set.
+	void Insert(Vertex v)
+	{
+		Resize((v >> 6) + 1);
+		words_[v >> 6] |= uint64_t(1) << (v & 63);
+	}
+	
+	// Removes v from the set.
+	void Erase(Vertex v)
+	{
+		if ((v >> 6) < WordCount()) words_[v >> 6] &= ~(uint64_t(1) << (v & 63));
+	}
+	
+	// Returns: if v is in the set.
+	bool Contains(Vertex v) const
+	{
+		return (Word(v >> 6) >> (v & 63)) & 1;
+	}
+	
+	// Removes all the vertices.
+	void Clear()
+	{
+		std::fill(words_.begin(), words_.end(), 0);
+	}
+	
+	// Returns: the number of vertices in the set.
+	int Count() const
+	{
+		int count = 0;
+		for (int i = 0; i < WordCount(); ++i) count += __builtin_popcountll(words_[i]);
+		return count;
+	}
+	
+	// Returns: if the set has no vertices.
+	bool Empty() const
+	{
+		for (int i = 0; i < WordCount(); ++i) if (words_[i]) return false;
+		return true;
+	}
+	
+	// Returns: if all the vertices of this set are in s.
+	bool IsSubsetOf(const VertexSet& s) const
+	{
+		for (int i = 0; i < WordCount(); ++i) if (words_[i] & ~s.Word(i)) return false;
+		return true;
+	}
+	
+	// Keeps only the vertices that are also in s.
+	VertexSet& operator&=(const VertexSet& s)
+	{
+		for (int i = 0; i < WordCount(); ++i) words_[i] &= s.Word(i);
+		return *this;
+	}
+	
+	// Adds the vertices of s.
+	VertexSet& operator|=(const VertexSet& s)
+	{
+		Resize(s.WordCount());
+		for (int i = 0; i < s.WordCount(); ++i) words_[i] |= s.words_[i];
+		return *this;
+	}
+	
+	// Returns: if both sets have the same vertices.
+	bool operator==(const VertexSet& s) const
+	{
+		for (int i = 0; i < std::max(WordCount(), s.WordCount()); ++i) if (Word(i) != s.Word(i)) return false;
+		return true;
+	}
+	
+	bool operator!=(const VertexSet& s) const
+	{
+		return !(*this == s);
+	}
+	
+	// Returns: the vertices in the set, sorted ascendingly.
+	std::vector<Vertex> Vertices() const
+	{
+		std::vector<Vertex> vertices;
+		for (int i = 0; i < WordCount(); ++i)
+			for (uint64_t word = words_[i]; word; word &= word - 1)
+				vertices.push_back(64 * i + __builtin_ctzll(word));
+		return vertices;
+	}
+	
+	// Returns: the number of words of the set.
+	int WordCount() const
+	{
+		return words_.size();
+	}
+	
+	// Returns: the i-th word of the set (0 if i >= WordCount()).
+	uint64_t Word(int i) const
+	{
+		return i < WordCount() ? words_[i] : 0;
+	}
+	
+private:
+	typedef typename std::conditional<W == 0, std::vector<uint64_t>, std::array<uint64_t, W>>::type Words;
+	
+	// Grows the dynamic sets to have at least word_count words (fixed size sets are not changed).
+	void Resize(int word_count)
+	{
+		resize(&words_, word_count);
+	}
+	
+	static void resize(std::vector<uint64_t>* words, int word_count)
+	{
+		if (words->size() < word_count) words->resize(word_count, 0);
+	}
+	
+	static void resize(std::array<uint64_t, W>* words, int word_count)
+	{ }
+	
+	Words words_; // words_[i] has the vertices {64*i, ..., 64*i+63}.
+};
+
+// Returns: The intersection of sets s1 and s2.
+template<int W>
+inline VertexSet<W> intersection(VertexSet<W> s1, const VertexSet<W>& s2)
+{
+	return s1 &= s2;
+}
+
+// Returns: The union of sets s1 and s2.
+template<int W>
+inline VertexSet<W> unite(VertexSet<W> s1, const VertexSet<W>& s2)
+{
+	return s1 |= s2;
+}
+
+// Returns: if s1 is a subset of s2
+template<int W>
+inline bool is_subset(const VertexSet<W>& s1, const VertexSet<W>& s2)
+{
+	return s1.IsSubsetOf(s2);
+}
+
+// Sets the json object j with the vertices of s.
+template<int W>
+void to_json(nlohmann::json& j, const VertexSet<W>& s)
+{
+	j = s.Vertices();
+}
+
+// Parses back a set from the json representation (a list of vertices).
+template<int W>
+void from_json(const nlohmann::json& j, VertexSet<W>& s)
+{
+	s.Clear();
+	for (Vertex v: j) s.Insert(v);
+}
 } // namespace goc
 
 namespace std
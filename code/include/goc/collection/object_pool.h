@@ -0,0 +1,72 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_COLLECTION_OBJECT_POOL_H
+#define GOC_COLLECTION_OBJECT_POOL_H
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace goc
+{
+// This class allocates objects of type T in slabs of contiguous memory, so creating and deleting many small objects
+// does not require one heap allocation per object. Deleted slots are reused by later allocations.
+// Observation: the addresses of the objects never change while they are alive.
+// Precondition: all the objects must be deleted before the pool is destroyed.
+template<typename T>
+class ObjectPool
+{
+public:
+	// slab_size: number of objects allocated together each time the pool runs out of free slots.
+	explicit ObjectPool(int slab_size=1024) : slab_size_(slab_size)
+	{ }
+	
+	ObjectPool(const ObjectPool&) = delete;
+	
+	ObjectPool& operator=(const ObjectPool&) = delete;
+	
+	// Creates an object in the pool constructed with 'args'.
+	// Returns: a pointer to the object, which is valid until it is deleted with Delete.
+	template<typename... Args>
+	T* New(Args&&... args)
+	{
+		if (free_slots_.empty()) AllocateSlab();
+		void* slot = free_slots_.back();
+		free_slots_.pop_back();
+		return new (slot) T{std::forward<Args>(args)...};
+	}
+	
+	// Destroys the object and releases its slot to be reused.
+	// Precondition: object was created by this pool and was not deleted yet.
+	// Observation: if object == nullptr, the call to the function is ignored.
+	void Delete(T* object)
+	{
+		if (!object) return;
+		object->~T();
+		free_slots_.push_back(object);
+	}
+	
+private:
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+	
+	// Allocates a new slab and adds its slots to the free slots.
+	void AllocateSlab()
+	{
+		slabs_.emplace_back(new Slot[slab_size_]);
+		Slot* slab = slabs_.back().get();
+		for (int i = slab_size_-1; i >= 0; --i) free_slots_.push_back(&slab[i]);
+	}
+	
+	int slab_size_; // number of objects in each slab.
+	std::vector<std::unique_ptr<Slot[]>> slabs_; // memory of the objects.
+	std::vector<void*> free_slots_; // slots that do not contain an object.
+};
+} // namespace goc
+
+#endif //GOC_COLLECTION_OBJECT_POOL_H
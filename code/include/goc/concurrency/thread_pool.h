@@ -0,0 +1,73 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_CONCURRENCY_THREAD_POOL_H
+#define GOC_CONCURRENCY_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace goc
+{
+// This class represents a fixed set of worker threads that execute batches of tasks.
+// Each call to Run is a barrier: it returns once all the tasks of the batch finished. The calling thread also executes
+// tasks while it waits, so a pool with thread_count threads creates only thread_count-1 workers (none if it is 1).
+// Run can be called concurrently from many threads, tasks of all the batches share the same workers.
+// Precondition: tasks must not throw exceptions.
+class ThreadPool
+{
+public:
+	// Creates a pool with thread_count threads (including the ones calling Run).
+	explicit ThreadPool(int thread_count);
+	
+	// Waits for the workers to finish their current task and stops them.
+	~ThreadPool();
+	
+	ThreadPool(const ThreadPool&) = delete;
+	
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	
+	// Executes all the tasks, possibly in parallel and in any order.
+	// Returns: once all the tasks were executed.
+	void Run(const std::vector<std::function<void()>>& tasks);
+	
+	// Returns: the number of threads that execute tasks (including the ones calling Run).
+	int ThreadCount() const;
+	
+private:
+	// Tasks of a call to Run, used to know when all of them finished.
+	struct Batch
+	{
+		int pending; // number of tasks not finished yet.
+		std::condition_variable finished; // notified when pending reaches 0.
+	};
+	
+	// A task waiting to be executed and the batch it belongs to.
+	struct Task
+	{
+		const std::function<void()>* function;
+		Batch* batch;
+	};
+	
+	// Executes the task and notifies its batch if it was the last one.
+	void Execute(const Task& task);
+	
+	// Loop of the worker threads.
+	void Work();
+	
+	std::vector<std::thread> workers_;
+	std::deque<Task> queue_; // tasks waiting to be executed.
+	std::mutex mutex_; // guards queue_, stopping_ and the batches.
+	std::condition_variable has_tasks_; // notified when tasks are added to the queue or the pool is stopping.
+	bool stopping_;
+};
+} // namespace goc
+
+#endif //GOC_CONCURRENCY_THREAD_POOL_H
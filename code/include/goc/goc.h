@@ -10,8 +10,11 @@
 #include "goc/collection/bitset_utils.h"
 #include "goc/collection/collection_utils.h"
 #include "goc/collection/matrix.h"
+#include "goc/collection/object_pool.h"
 #include "goc/collection/vector_map.h"
 
+#include "goc/concurrency/thread_pool.h"
+
 #include "goc/exception/exception_utils.h"
 
 #include "goc/graph/arc.h"
@@ -24,18 +27,27 @@
 #include "goc/graph/vertex.h"
 
 #include "goc/json/json_utils.h"
+#include "goc/labeling/bidirectional_labeling.h"
+#include "goc/labeling/monodirectional_labeling.h"
+#include "goc/labeling/ng_route.h"
 
 #include "goc/lib/json.hpp"
 
+#include "goc/linear_programming/cuts/cut_pool.h"
 #include "goc/linear_programming/cuts/separation_routine.h"
+#include "goc/linear_programming/cuts/separation_routine_executor.h"
 #include "goc/linear_programming/cuts/separation_strategy.h"
 #include "goc/linear_programming/model/branch_priority.h"
+#include "goc/linear_programming/model/column_builder.h"
 #include "goc/linear_programming/model/constraint.h"
+#include "goc/linear_programming/model/dense_valuation.h"
 #include "goc/linear_programming/model/expression.h"
 #include "goc/linear_programming/model/formulation.h"
+#include "goc/linear_programming/model/row_builder.h"
 #include "goc/linear_programming/model/valuation.h"
 #include "goc/linear_programming/model/variable.h"
 #include "goc/linear_programming/solver/bc_solver.h"
+#include "goc/linear_programming/solver/bcp_solver.h"
 #include "goc/linear_programming/solver/cg_solver.h"
 #include "goc/linear_programming/solver/lp_solver.h"
 
@@ -10,6 +10,7 @@
 #include <limits.h>
 #include <vector>
 
+#include "goc/collection/bitset_utils.h"
 #include "goc/graph/vertex.h"
 
 namespace goc
@@ -19,6 +20,11 @@ typedef std::vector<Vertex> GraphPath;
 
 // Returns: if the path 'p' contains a cycle of size 'max_size' vertices or less.
 bool has_cycle(GraphPath p, int max_size=INT_MAX);
+
+// Returns: if the path 'p' contains a cycle forbidden by the ng-neighbourhoods, i.e. it is not an ng-route.
+// The memory of the path (p[0]) is {p[0]}, and the memory of (p[0], ..., p[k]) is the memory of (p[0], ..., p[k-1])
+// intersected with ng_neighbourhoods[p[k]], plus p[k]. The path is forbidden if p[k] is in the memory of p[0..k-1].
+bool has_ng_cycle(const GraphPath& p, const std::vector<VertexSet<>>& ng_neighbourhoods);
 } // namespace goc
 
 #endif //GOC_GRAPH_GRAPH_PATH_H
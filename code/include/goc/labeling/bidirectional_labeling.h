@@ -0,0 +1,203 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LABELING_BIDIRECTIONAL_LABELING_H
+#define GOC_LABELING_BIDIRECTIONAL_LABELING_H
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits.h>
+#include <set>
+#include <vector>
+
+#include "goc/concurrency/thread_pool.h"
+#include "goc/graph/digraph.h"
+#include "goc/graph/graph_path.h"
+#include "goc/graph/vertex.h"
+#include "goc/labeling/monodirectional_labeling.h"
+#include "goc/log/blb_execution_log.h"
+#include "goc/math/number_utils.h"
+#include "goc/time/duration.h"
+#include "goc/time/stopwatch.h"
+
+namespace goc
+{
+// This class implements a bidirectional labeling algorithm for the resource constrained shortest path problem.
+// A forward labeling extends paths from the source while their monotone resource is at most the midpoint, and a
+// backward labeling extends paths from the sink (on the reverse digraph) while their monotone resource is at most
+// resource_bound - midpoint. Then forward and backward labels at the same vertex are merged into complete paths.
+// - ForwardProblem: resources of the forward labeling (see MonodirectionalLabeling).
+// - BackwardProblem: resources of the backward labeling (see MonodirectionalLabeling). Its arcs are the ones of the
+//	 reverse digraph, so an arc (j, i) extends a path starting at j to start at i.
+// - Merger: type with the functions
+//	- double ForwardKey(const ForwardProblem::Resources& r) const;
+//	- double BackwardKey(const BackwardProblem::Resources& r) const;
+//		Returns: keys such that a forward path and a backward path ending at the same vertex can only be merged if the
+//		forward key is at most the backward key (e.g. arrival time and latest arrival time, or load and capacity
+//		minus the backward load).
+//	- bool Merge(Vertex v, const ForwardProblem::Resources& f, const BackwardProblem::Resources& b) const;
+//		Returns: if the forward path and the backward path ending at v form a feasible path.
+//	The cost of a merged path is the sum of the costs of both paths (so the cost of v must not be counted twice).
+// Precondition: every path is the merge of a forward path whose prefix without v has monotone resource at most the
+// midpoint, and a backward path from v whose suffix without v has monotone resource at most resource_bound - midpoint
+// (e.g. v is the first vertex where the forward monotone resource exceeds the midpoint).
+// Backward labels of each vertex are sorted by their key, so each forward label is only merged with the backward
+// labels with a key that is large enough, and only if the cheapest of them gives a cost smaller than the cost limit.
+template<typename ForwardProblem, typename BackwardProblem, typename Merger>
+class BidirectionalLabeling
+{
+public:
+	typedef typename MonodirectionalLabeling<ForwardProblem>::Label ForwardLabel;
+	typedef typename MonodirectionalLabeling<BackwardProblem>::Label BackwardLabel;
+
+	// A path from the source to the sink, merged from a forward label and a backward label at the same vertex.
+	struct Solution
+	{
+		const ForwardLabel* forward; // path from the source to the merge vertex.
+		const BackwardLabel* backward; // path from the merge vertex to the sink (reversed).
+		double cost; // cost of the path.
+
+		// Returns: the path from the source to the sink.
+		GraphPath Path() const
+		{
+			GraphPath path = forward->Path();
+			GraphPath suffix = backward->Path();
+			path.insert(path.end(), suffix.rbegin() + 1, suffix.rend());
+			return path;
+		}
+	};
+
+	// Maximum time to spend.
+	Duration time_limit;
+	// Maximum number of labels to process in each direction.
+	int process_limit;
+	// Only paths with a cost smaller than this are solutions.
+	double cost_limit;
+	// Maximum number of solutions (the merge stops with SolutionLimitReached when they are found).
+	int solution_limit;
+	// Upper bound of the monotone resource of a complete path (e.g. the time horizon or the capacity).
+	double resource_bound;
+	// Forward labels are only extended while their monotone resource is at most this value (by default, half the
+	// resource bound).
+	double midpoint;
+	// Width of the buckets of the monotone resources.
+	double bucket_width;
+	// If true, the forward and the backward labeling run on two threads.
+	bool parallel;
+
+	// Creates a bidirectional labeling for paths from source to sink in the digraph (time_limit=Max,
+	//	process_limit=INT_MAX, cost_limit=INFTY, solution_limit=INT_MAX, midpoint=resource_bound/2, bucket_width=1,
+	//	parallel=false).
+	// Observation: the digraph and the problems are kept by reference.
+	BidirectionalLabeling(const Digraph& digraph, const ForwardProblem& forward_problem,
+		const BackwardProblem& backward_problem, const Merger& merger, Vertex source, Vertex sink, double resource_bound)
+		: time_limit(Duration::Max()), process_limit(INT_MAX), cost_limit(INFTY), solution_limit(INT_MAX),
+		  resource_bound(resource_bound), midpoint(resource_bound / 2.0), bucket_width(1.0), parallel(false),
+		  reverse_(digraph.Reverse()), merger_(merger), forward_(digraph, forward_problem, source, sink),
+		  backward_(reverse_, backward_problem, sink, source)
+	{ }
+
+	// Runs both labeling algorithms and merges their labels, filling the execution log.
+	// Returns: the paths with a cost smaller than cost_limit (each path once), sorted by cost.
+	// Observation: if a direction stops because of the time or process limit, the status says which limit was reached
+	// (the time limit if both were), and the labels it processed are still merged. Those solutions are feasible paths,
+	// but some paths with a cost smaller than cost_limit might be missing. If the time limit is reached during the
+	// merge, the solutions found so far are returned.
+	// Observation: solutions are valid until the algorithm is run again or destroyed.
+	std::vector<Solution> Run(BLBExecutionLog* log)
+	{
+		Stopwatch rolex(true);
+		*log = BLBExecutionLog();
+		log->status = BLBStatus::Finished;
+
+		// Forward and backward labeling. The cost limit only applies to complete paths. When they run one after the
+		// other, the backward labeling only gets the time left by the forward one.
+		forward_.time_limit = backward_.time_limit = time_limit;
+		forward_.process_limit = backward_.process_limit = process_limit;
+		forward_.bucket_width = backward_.bucket_width = bucket_width;
+		forward_.extension_limit = midpoint;
+		backward_.extension_limit = resource_bound - midpoint;
+		if (parallel)
+		{
+			ThreadPool thread_pool(2);
+			thread_pool.Run({[&] { forward_.Run(&log->forward_log); }, [&] { backward_.Run(&log->backward_log); }});
+		}
+		else
+		{
+			forward_.Run(&log->forward_log);
+			backward_.time_limit = time_limit - rolex.Peek();
+			backward_.Run(&log->backward_log);
+		}
+		for (MLBStatus status: {log->forward_log.status, log->backward_log.status})
+		{
+			if (status == MLBStatus::TimeLimitReached) log->status = BLBStatus::TimeLimitReached;
+			else if (status == MLBStatus::ProcessLimitReached && log->status == BLBStatus::Finished)
+				log->status = BLBStatus::ProcessLimitReached;
+		}
+
+		// Merge the labels of each vertex.
+		Stopwatch merge_rolex(true);
+		std::vector<Solution> solutions;
+		std::set<GraphPath> paths; // paths found, as they can be merged at many of their vertices.
+		bool stop = false; // if the time or solution limit was reached during the merge.
+		for (Vertex v = 0; v < reverse_.VertexCount() && !stop; ++v)
+		{
+			// Sort the backward labels by decreasing key, and keep the cheapest cost of each prefix.
+			std::vector<const BackwardLabel*> backward = backward_.ProcessedLabels(v);
+			if (backward.empty()) continue;
+			std::vector<double> backward_key(backward.size());
+			std::sort(backward.begin(), backward.end(), [&] (const BackwardLabel* b1, const BackwardLabel* b2) {
+				return merger_.BackwardKey(b1->resources) > merger_.BackwardKey(b2->resources);
+			});
+			std::vector<double> cheapest(backward.size());
+			for (int k = 0; k < backward.size(); ++k)
+			{
+				backward_key[k] = merger_.BackwardKey(backward[k]->resources);
+				cheapest[k] = k == 0 ? backward[k]->cost : std::min(cheapest[k-1], backward[k]->cost);
+			}
+			for (const ForwardLabel* forward: forward_.ProcessedLabels(v))
+			{
+				if (rolex.Peek() >= time_limit) { log->status = BLBStatus::TimeLimitReached; stop = true; break; }
+
+				// Backward labels [0, end) have a key at least the forward key.
+				double key = merger_.ForwardKey(forward->resources);
+				int end = std::upper_bound(backward_key.begin(), backward_key.end(), key, std::greater<double>()) - backward_key.begin();
+				while (end < backward.size() && epsilon_equal(backward_key[end], key)) ++end;
+				if (end == 0 || !improves(forward->cost + cheapest[end-1])) continue;
+				for (int k = 0; k < end; ++k)
+				{
+					double cost = forward->cost + backward[k]->cost;
+					if (!improves(cost) || !merger_.Merge(v, forward->resources, backward[k]->resources)) continue;
+					Solution solution{forward, backward[k], cost};
+					if (!paths.insert(solution.Path()).second) continue;
+					solutions.push_back(solution);
+					if (solutions.size() >= solution_limit) { log->status = BLBStatus::SolutionLimitReached; stop = true; break; }
+				}
+				if (stop) break;
+			}
+		}
+		std::sort(solutions.begin(), solutions.end(), [] (const Solution& s1, const Solution& s2) { return s1.cost < s2.cost; });
+		log->merge_time = merge_rolex.Pause();
+		log->time = rolex.Peek();
+		return solutions;
+	}
+
+private:
+	// Returns: if a path with this cost is a solution.
+	bool improves(double cost) const
+	{
+		return fabs(cost_limit) >= INFTY || epsilon_smaller(cost, cost_limit);
+	}
+
+	Digraph reverse_; // reverse of the digraph, where the backward labeling runs.
+	const Merger& merger_; // merges forward and backward labels.
+	MonodirectionalLabeling<ForwardProblem> forward_; // labeling from the source.
+	MonodirectionalLabeling<BackwardProblem> backward_; // labeling from the sink on the reverse digraph.
+};
+} // namespace goc
+
+#endif //GOC_LABELING_BIDIRECTIONAL_LABELING_H
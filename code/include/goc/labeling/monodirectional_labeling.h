@@ -0,0 +1,266 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LABELING_MONODIRECTIONAL_LABELING_H
+#define GOC_LABELING_MONODIRECTIONAL_LABELING_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits.h>
+#include <vector>
+
+#include "goc/collection/object_pool.h"
+#include "goc/exception/exception_utils.h"
+#include "goc/graph/arc.h"
+#include "goc/graph/digraph.h"
+#include "goc/graph/graph_path.h"
+#include "goc/graph/vertex.h"
+#include "goc/log/mlb_execution_log.h"
+#include "goc/math/number_utils.h"
+#include "goc/time/duration.h"
+#include "goc/time/stopwatch.h"
+
+namespace goc
+{
+// A label of a labeling algorithm: a path from the source to 'vertex', with its cost and resource consumption.
+template<typename Resources>
+struct Label
+{
+	const Label* parent; // label extended to create this one (nullptr for the label at the source).
+	Vertex vertex; // last vertex of the path.
+	double cost; // cost of the path.
+	Resources resources; // resource consumption of the path.
+	int length; // number of arcs of the path.
+
+	// Returns: the path from the source to the vertex of the label.
+	GraphPath Path() const
+	{
+		GraphPath path;
+		for (const Label* l = this; l; l = l->parent) path.push_back(l->vertex);
+		std::reverse(path.begin(), path.end());
+		return path;
+	}
+};
+
+// This class implements a labeling algorithm for the resource constrained shortest path problem on a digraph.
+// The resources are defined at compile time by the type Problem, which must have:
+//	- typedef R Resources;
+//	- Resources InitialResources() const;
+//		Returns: the resources at the source.
+//	- bool Extend(const Resources& r, const Arc& e, Resources* extended, double* cost) const;
+//		Returns: if a path with resources r can be extended by arc e. If so, sets the resources after e and the cost
+//		of e.
+//	- bool Dominates(const Resources& r1, const Resources& r2) const;
+//		Returns: if a path with resources r1 dominates a path with resources r2 that ends at the same vertex and has
+//		a cost not smaller (every feasible extension of the second is a feasible extension of the first).
+//	- double MonotoneResource(const Resources& r) const;
+//		Returns: a non-negative resource that never decreases when extending a path (e.g. time or load).
+//	- double CompletionBound(Vertex v, const Resources& r) const;
+//		Returns: a lower bound of the cost to extend a path ending at v with resources r to the sink (-INFTY if none).
+// Labels are kept in buckets indexed by the monotone resource, and are processed in bucket order, so labels are
+// usually dominated before being extended.
+// Every stage of a label is counted in the execution log:
+//	1 - enumeration: an arc is considered to extend a label.
+//	2 - extension: the extension is feasible, and the new label is put in its bucket.
+//	3 - bounding: the label can not reach the sink with a cost smaller than the cost limit.
+//	4 - domination: the label is dominated by a label already processed at its vertex.
+//	5 - process: the label is added to the labels of its vertex (correcting the ones it dominates, which are removed).
+// The time of each stage is only measured if profiling is set, once per label (the enumeration and extension of all the
+// successors of a label, including pushing them to their buckets, are timed together as extension time).
+// Example:
+//	MonodirectionalLabeling<ESPPRC> labeling(D, problem, 0, n+1);
+//	labeling.cost_limit = 0.0;
+//	MLBExecutionLog log;
+//	auto routes = labeling.Run(&log); // labels at the sink with negative cost, sorted by cost.
+template<typename Problem>
+class MonodirectionalLabeling
+{
+public:
+	typedef typename Problem::Resources Resources;
+	typedef goc::Label<Resources> Label;
+
+	// Maximum time to spend.
+	Duration time_limit;
+	// Maximum number of labels to process.
+	int process_limit;
+	// Only labels at the sink with a cost smaller than this are solutions, and labels that can not reach the sink with
+	// such a cost are discarded.
+	double cost_limit;
+	// Width of the buckets of the monotone resource.
+	double bucket_width;
+	// Labels whose monotone resource is bigger than this value are processed but not extended (e.g. the midpoint of a
+	// bidirectional labeling).
+	double extension_limit;
+	// If true, the time spent in each stage is measured (it adds a few clock reads per label).
+	bool profiling;
+
+	// Creates a labeling algorithm for paths from source to sink in the digraph (time_limit=Max,
+	// 	process_limit=INT_MAX, cost_limit=INFTY, bucket_width=1, extension_limit=INFTY, profiling=false).
+	// Observation: the digraph and the problem are kept by reference.
+	MonodirectionalLabeling(const Digraph& digraph, const Problem& problem, Vertex source, Vertex sink)
+		: time_limit(Duration::Max()), process_limit(INT_MAX), cost_limit(INFTY), bucket_width(1.0),
+		  extension_limit(INFTY), profiling(false), digraph_(digraph), problem_(problem), source_(source), sink_(sink)
+	{ }
+
+	MonodirectionalLabeling(const MonodirectionalLabeling&) = delete;
+
+	MonodirectionalLabeling& operator=(const MonodirectionalLabeling&) = delete;
+
+	~MonodirectionalLabeling()
+	{
+		Clear();
+	}
+
+	// Runs the labeling algorithm, filling the execution log.
+	// Returns: the labels processed at the sink with a cost smaller than cost_limit, sorted by cost.
+	// Observation: labels are valid until the algorithm is run again or destroyed.
+	std::vector<const Label*> Run(MLBExecutionLog* log)
+	{
+		Stopwatch rolex(true), queuing_rolex(false), extension_rolex(false), bounding_rolex(false),
+			domination_rolex(false), correction_rolex(false), process_rolex(false);
+		auto resume = [&] (Stopwatch& stage_rolex) { if (profiling) stage_rolex.Resume(); };
+		auto pause = [&] (Stopwatch& stage_rolex) { if (profiling) stage_rolex.Pause(); };
+		*log = MLBExecutionLog();
+		log->status = MLBStatus::Finished;
+		Clear();
+		processed_.assign(digraph_.VertexCount(), {});
+
+		// buckets[b] has the labels whose monotone resource is in [b * bucket_width, (b+1) * bucket_width).
+		std::vector<std::vector<Label*>> buckets;
+		auto push = [&] (Label* label) {
+			double resource = problem_.MonotoneResource(label->resources);
+			if (resource < 0.0) fail("The monotone resource of the labeling must be non negative.");
+			int b = (int)floor(resource / bucket_width);
+			if (b >= buckets.size()) buckets.resize(b + 1);
+			buckets[b].push_back(label);
+		};
+		push(NewLabel(nullptr, source_, 0.0, problem_.InitialResources(), 0));
+		for (int b = 0; b < buckets.size(); ++b)
+		{
+			// Labels extended without increasing the monotone resource enough are added to the bucket while it is
+			// being processed.
+			for (int k = 0; k < buckets[b].size(); ++k)
+			{
+				if (rolex.Peek() >= time_limit) { log->status = MLBStatus::TimeLimitReached; break; }
+				if (log->processed_count >= process_limit) { log->status = MLBStatus::ProcessLimitReached; break; }
+				resume(queuing_rolex);
+				Label* label = buckets[b][k];
+				pause(queuing_rolex);
+
+				// Bounding.
+				resume(bounding_rolex);
+				bool bounded = label->vertex != sink_ && fabs(cost_limit) < INFTY &&
+					epsilon_bigger_equal(label->cost + problem_.CompletionBound(label->vertex, label->resources), cost_limit);
+				pause(bounding_rolex);
+				if (bounded) { ++log->bounded_count; continue; }
+
+				// Domination.
+				resume(domination_rolex);
+				bool dominated = false;
+				for (const Label* processed: processed_[label->vertex])
+				{
+					if (epsilon_smaller_equal(processed->cost, label->cost) && problem_.Dominates(processed->resources, label->resources))
+					{
+						dominated = true;
+						break;
+					}
+				}
+				pause(domination_rolex);
+				if (dominated) { ++log->dominated_count; continue; }
+
+				// Correction: remove the labels of the vertex dominated by the new one (they might be parents of labels
+				// in the buckets, so they are kept alive).
+				resume(correction_rolex);
+				auto& vertex_labels = processed_[label->vertex];
+				int remaining = 0;
+				for (const Label* processed: vertex_labels)
+				{
+					if (epsilon_smaller_equal(label->cost, processed->cost) && problem_.Dominates(label->resources, processed->resources))
+						++log->corrected_count;
+					else
+						vertex_labels[remaining++] = processed;
+				}
+				vertex_labels.resize(remaining);
+				pause(correction_rolex);
+
+				// Process.
+				resume(process_rolex);
+				vertex_labels.push_back(label);
+				++log->processed_count;
+				if (label->length >= log->count_by_length.size()) log->count_by_length.resize(label->length + 1, 0);
+				++log->count_by_length[label->length];
+				pause(process_rolex);
+				if (label->vertex == sink_ || epsilon_bigger(problem_.MonotoneResource(label->resources), extension_limit)) continue;
+
+				// Enumeration and extension of the successors.
+				resume(extension_rolex);
+				for (const Arc& e: digraph_.OutboundArcs(label->vertex))
+				{
+					++log->enumerated_count;
+					Resources resources;
+					double cost = 0.0;
+					if (!problem_.Extend(label->resources, e, &resources, &cost)) continue;
+					++log->extended_count;
+					Label* extended = NewLabel(label, e.head, label->cost + cost, resources, label->length + 1);
+					if (problem_.MonotoneResource(resources) < problem_.MonotoneResource(label->resources))
+						fail("The monotone resource of the labeling decreased when extending a label.");
+					push(extended);
+				}
+				pause(extension_rolex);
+			}
+			if (log->status != MLBStatus::Finished) break;
+		}
+
+		// Solutions are the labels at the sink with cost smaller than the limit.
+		std::vector<const Label*> solutions;
+		for (const Label* label: processed_[sink_])
+			if (fabs(cost_limit) >= INFTY || epsilon_smaller(label->cost, cost_limit))
+				solutions.push_back(label);
+		std::sort(solutions.begin(), solutions.end(), [] (const Label* l1, const Label* l2) { return l1->cost < l2->cost; });
+
+		log->queuing_time = queuing_rolex.Peek();
+		log->extension_time = extension_rolex.Peek();
+		log->bounding_time = bounding_rolex.Peek();
+		log->domination_time = domination_rolex.Peek();
+		log->correction_time = correction_rolex.Peek();
+		log->process_time = process_rolex.Peek();
+		log->time = rolex.Peek();
+		return solutions;
+	}
+
+	// Returns: the labels processed at vertex v in the last run that were not corrected.
+	const std::vector<const Label*>& ProcessedLabels(Vertex v) const
+	{
+		return processed_[v];
+	}
+
+private:
+	// Returns: a new label with the given attributes.
+	Label* NewLabel(const Label* parent, Vertex vertex, double cost, const Resources& resources, int length)
+	{
+		Label* label = label_pool_.New(parent, vertex, cost, resources, length);
+		labels_.push_back(label);
+		return label;
+	}
+
+	// Deletes all the labels.
+	void Clear()
+	{
+		for (Label* label: labels_) label_pool_.Delete(label);
+		labels_.clear();
+		processed_.clear();
+	}
+
+	const Digraph& digraph_; // digraph where paths are searched.
+	const Problem& problem_; // resources of the paths.
+	Vertex source_, sink_; // paths go from source to sink.
+	ObjectPool<Label> label_pool_; // memory of the labels.
+	std::vector<Label*> labels_; // labels created in the last run.
+	std::vector<std::vector<const Label*>> processed_; // processed_[v] are the labels processed at v not corrected.
+};
+} // namespace goc
+
+#endif //GOC_LABELING_MONODIRECTIONAL_LABELING_H
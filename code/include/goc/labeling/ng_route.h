@@ -0,0 +1,142 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LABELING_NG_ROUTE_H
+#define GOC_LABELING_NG_ROUTE_H
+
+#include <functional>
+#include <limits.h>
+#include <vector>
+
+#include "goc/collection/bitset_utils.h"
+#include "goc/exception/exception_utils.h"
+#include "goc/graph/arc.h"
+#include "goc/graph/graph_path.h"
+#include "goc/graph/vertex.h"
+
+namespace goc
+{
+// Returns: the ng-neighbourhoods where the neighbourhood of each vertex v has v and the size-1 closest vertices to v.
+//	- vertex_count: number of vertices.
+//	- size: number of vertices of each neighbourhood.
+//	- distance(v, w): distance from v to w.
+std::vector<VertexSet<>> closest_ng_neighbourhoods(int vertex_count, int size,
+	const std::function<double(Vertex, Vertex)>& distance);
+
+// Grows the ng-neighbourhoods so the cycles of the path are forbidden (e.g. the paths of the columns added in a column
+// generation iteration). For each cycle (i, ..., i) of the path, i is added to the neighbourhoods of the vertices
+// inside the cycle, unless they already have max_size vertices.
+// Returns: if any neighbourhood changed.
+bool grow_ng_neighbourhoods(const GraphPath& path, int max_size, std::vector<VertexSet<>>* ng_neighbourhoods);
+
+// This class adds the ng-route relaxation to the resources of a labeling Problem (see MonodirectionalLabeling).
+// Each label keeps a memory with the vertices it can not visit: extending a path to w keeps the vertices of the memory
+// that are in the ng-neighbourhood of w, and adds w. Paths might have cycles, but only those that leave the
+// neighbourhood of the repeated vertex. With neighbourhoods of all the vertices, paths are elementary.
+// The memories are VertexSet<W>, so they are kept inside the labels (W*64 must be at least the number of vertices).
+// Example:
+//	NGRouteProblem<ESPPRC, 2> ng_problem(problem, closest_ng_neighbourhoods(n, 8, distance), source);
+//	MonodirectionalLabeling<NGRouteProblem<ESPPRC, 2>> labeling(D, ng_problem, source, sink);
+template<typename Problem, int W>
+class NGRouteProblem
+{
+public:
+	// Resources of the problem plus the ng-memory.
+	struct Resources
+	{
+		typename Problem::Resources resources; // resources of the problem.
+		VertexSet<W> memory; // vertices that can not be visited.
+	};
+	
+	// Observation: the problem is kept by reference, the neighbourhoods are copied.
+	// Precondition: there is a neighbourhood for each vertex, and there are at most 64*W vertices (it fails otherwise).
+	NGRouteProblem(const Problem& problem, const std::vector<VertexSet<>>& ng_neighbourhoods, Vertex source)
+		: problem_(problem), source_(source)
+	{
+		SetNeighbourhoods(ng_neighbourhoods);
+		if (source_ >= ng_neighbourhoods.size()) fail("The source of the ng-route problem has no neighbourhood.");
+	}
+	
+	// Replaces the ng-neighbourhoods (e.g. after growing them between column generation iterations).
+	// Precondition: there is a neighbourhood for each vertex, and there are at most 64*W vertices (it fails otherwise).
+	void SetNeighbourhoods(const std::vector<VertexSet<>>& ng_neighbourhoods)
+	{
+		if (ng_neighbourhoods.size() > 64 * W) fail("The ng-route memories have less than one bit per vertex.");
+		neighbourhoods_.clear();
+		for (auto& neighbourhood: ng_neighbourhoods) neighbourhoods_.push_back(VertexSet<W>(neighbourhood));
+	}
+	
+	Resources InitialResources() const
+	{
+		return {problem_.InitialResources(), {source_}};
+	}
+	
+	bool Extend(const Resources& r, const Arc& e, Resources* extended, double* cost) const
+	{
+		if (r.memory.Contains(e.head)) return false;
+		if (!problem_.Extend(r.resources, e, &extended->resources, cost)) return false;
+		extended->memory = r.memory;
+		extended->memory &= neighbourhoods_[e.head];
+		extended->memory.Insert(e.head);
+		return true;
+	}
+	
+	// Observation: a smaller memory allows more extensions, so it is also needed to dominate.
+	bool Dominates(const Resources& r1, const Resources& r2) const
+	{
+		return r1.memory.IsSubsetOf(r2.memory) && problem_.Dominates(r1.resources, r2.resources);
+	}
+	
+	double MonotoneResource(const Resources& r) const
+	{
+		return problem_.MonotoneResource(r.resources);
+	}
+	
+	double CompletionBound(Vertex v, const Resources& r) const
+	{
+		return problem_.CompletionBound(v, r.resources);
+	}
+	
+private:
+	const Problem& problem_; // problem whose resources are extended.
+	Vertex source_; // first vertex of the paths.
+	std::vector<VertexSet<W>> neighbourhoods_; // ng-neighbourhood of each vertex.
+};
+
+// This class adds the ng-route relaxation to a Merger of a bidirectional labeling (see BidirectionalLabeling), whose
+// problems are NGRouteProblem. A forward and a backward path ending at v can only be merged if v is the only vertex in
+// both memories.
+template<typename Merger, typename ForwardResources, typename BackwardResources>
+class NGRouteMerger
+{
+public:
+	// Observation: the merger is kept by reference.
+	NGRouteMerger(const Merger& merger) : merger_(merger)
+	{ }
+	
+	double ForwardKey(const ForwardResources& r) const
+	{
+		return merger_.ForwardKey(r.resources);
+	}
+	
+	double BackwardKey(const BackwardResources& r) const
+	{
+		return merger_.BackwardKey(r.resources);
+	}
+	
+	bool Merge(Vertex v, const ForwardResources& f, const BackwardResources& b) const
+	{
+		auto common = f.memory;
+		common &= b.memory;
+		return common.Count() == 1 && common.Contains(v) && merger_.Merge(v, f.resources, b.resources);
+	}
+	
+private:
+	const Merger& merger_; // merger of the resources of the problems.
+};
+} // namespace goc
+
+#endif //GOC_LABELING_NG_ROUTE_H
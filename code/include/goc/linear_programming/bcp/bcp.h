@@ -0,0 +1,47 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_BCP_BCP_H
+#define GOC_LINEAR_PROGRAMMING_BCP_BCP_H
+
+#include <iostream>
+#include <unordered_set>
+
+#include "goc/linear_programming/cuts/separation_strategy.h"
+#include "goc/linear_programming/model/formulation.h"
+#include "goc/linear_programming/solver/bcp_solver.h"
+#include "goc/linear_programming/solver/cg_solver.h"
+#include "goc/log/bcp_execution_log.h"
+#include "goc/time/duration.h"
+
+namespace goc
+{
+// formulation: Master problem formulation (the root node is solved on it).
+// screen_output: Stream where the output to screen should be sent.
+// time_limit: Maximum time that might be spent on this method.
+// cg_solver: Column generation solver for the nodes.
+// separation_strategy: Cuts separated on the master after the column generation of each node (without a cut pool).
+// branching_rule: Rule that creates the children of the nodes with fractional solutions (it must be set).
+// node_pricing: If set, gives the pricing oracles of each node.
+// artificial_cost: Cost of each unit of violation of a row in the masters of the nodes (see BCPSolver::artificial_cost).
+// thread_count: Number of threads solving nodes at the same time (see BCPSolver::thread_count).
+// deterministic: If the nodes should be solved in rounds, to make the search reproducible.
+// options: Which options of the execution to keep track of.
+// Returns: the execution log of the branch and price with the specified options.
+BCPExecutionLog solve_bcp(Formulation* formulation,
+						  std::ostream* screen_output,
+						  Duration time_limit,
+						  const CGSolver& cg_solver,
+						  const SeparationStrategy& separation_strategy,
+						  const BranchingRule& branching_rule,
+						  const NodePricingFunction& node_pricing,
+						  double artificial_cost,
+						  int thread_count,
+						  bool deterministic,
+						  const std::unordered_set<BCOption>& options);
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_BCP_BCP_H
@@ -22,15 +22,32 @@ namespace goc
 // formulation: Master problem formulation.
 // screen_output: Stream where the output to screen should be sent.
 // time_limit: Maximum time that might be spent on this method.
-// pricing_function: Function that given a set of dual variables and the objective value finds and adds entering variables to the master formulation base.
+// pricing_oracles: Hierarchy of functions that given a set of dual variables and the objective value find entering variables for the master formulation base (see PricingOracle).
+// pricing_thread_count: Number of threads used to call the oracles of the same level concurrently.
 // lp_solver: Linear relaxation solver.
+// smoothing_alpha: Wentges smoothing factor applied to the duals sent to the pricing function (0 disables it).
+// automatic_smoothing: if the smoothing factor should be adapted after each pricing (see CGSolver::smoothing_alpha).
+// convexity_bound: upper bound on the sum of the master variables, used for the Lagrangian bound (0: no bound).
+// gap_limit: stop when the relative gap between the lp value and the Lagrangian bound is at most this value.
+// cutoff: stop when the Lagrangian bound shows the master can not improve this value (INFTY or -INFTY: no cutoff).
+// column_age_limit: iterations a column can go without improving the master before it is moved to the column pool
+//	(0: no column pool).
+// pool_extract_limit: maximum number of pooled columns added back to the master in an iteration.
 // options: Which options of the execution to keep track of.
 // Returns: the execution log of the column generation with the specified options.
 CGExecutionLog solve_colgen(Formulation* formulation,
 				   std::ostream* screen_output,
 				   Duration time_limit,
-				   const PricingFunction& pricing_function,
+				   const std::vector<PricingOracle>& pricing_oracles,
+				   int pricing_thread_count,
 				   LPSolver* lp_solver,
+				   double smoothing_alpha,
+				   bool automatic_smoothing,
+				   double convexity_bound,
+				   double gap_limit,
+				   double cutoff,
+				   int column_age_limit,
+				   int pool_extract_limit,
 				   const std::unordered_set<CGOption>& options);
 } // namespace goc
 
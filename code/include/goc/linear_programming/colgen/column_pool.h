@@ -0,0 +1,57 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_COLGEN_COLUMN_POOL_H
+#define GOC_LINEAR_PROGRAMMING_COLGEN_COLUMN_POOL_H
+
+#include <climits>
+#include <vector>
+
+#include "goc/linear_programming/model/column_builder.h"
+
+namespace goc
+{
+// This class keeps the columns removed from a restricted master problem, so they can be priced again cheaply before
+// calling the pricing oracle.
+// Columns are stored in compressed sparse column format (see ColumnBuilder), so the reduced costs of all of them are
+// computed in a single pass over contiguous arrays.
+class ColumnPool
+{
+public:
+	// Creates an empty pool.
+	ColumnPool();
+	
+	// Adds all the columns to the pool.
+	void Add(const ColumnBuilder& columns);
+	
+	// Sets reduced_costs[j] with the reduced cost c_j - duals * A_j of the j-th column in the pool.
+	// duals: dual values of the constraints of the master (constraints with index >= duals.size() have dual 0).
+	void ReducedCosts(const std::vector<double>& duals, std::vector<double>* reduced_costs) const;
+	
+	// Returns: the positions of up to count_limit columns with the best improving reduced cost (negative if
+	// minimizing, positive if maximizing), sorted from the best to the worst.
+	std::vector<int> MostImproving(const std::vector<double>& duals, bool minimizing, int count_limit=INT_MAX) const;
+	
+	// Moves up to count_limit columns with the best improving reduced cost (negative if minimizing, positive if
+	// maximizing) from the pool to 'columns'.
+	// duals: dual values of the constraints of the master.
+	// minimizing: if the master is a minimization problem.
+	// Returns: the number of columns moved.
+	int Extract(const std::vector<double>& duals, bool minimizing, ColumnBuilder* columns, int count_limit=INT_MAX);
+	
+	// Returns: the number of columns in the pool.
+	int Size() const;
+	
+	// Removes all the columns from the pool.
+	void Clear();
+	
+private:
+	ColumnBuilder columns_; // columns in the pool.
+	int row_count_; // 1 + the maximum constraint index in the columns.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_COLGEN_COLUMN_POOL_H
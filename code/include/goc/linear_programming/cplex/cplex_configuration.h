@@ -0,0 +1,71 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_CPLEX_CPLEX_CONFIGURATION_H
+#define GOC_LINEAR_PROGRAMMING_CPLEX_CPLEX_CONFIGURATION_H
+
+#include <string>
+#include <vector>
+
+#include "goc/lib/json.hpp"
+#include "goc/linear_programming/cplex/cplex_wrapper.h"
+
+namespace goc
+{
+// A CPLEX parameter with its value.
+struct CplexParameter
+{
+	int number; // CPLEX number of the parameter (e.g. CPX_PARAM_TILIM).
+	int type; // CPX_PARAMTYPE_INT, CPX_PARAMTYPE_LONG, CPX_PARAMTYPE_DOUBLE or CPX_PARAMTYPE_STRING.
+	CPXLONG integer_value; // value if the type is int or long.
+	double double_value; // value if the type is double.
+	std::string string_value; // value if the type is string.
+	
+	// Returns: if both parameters have the same number, type and value.
+	bool operator==(const CplexParameter& parameter) const;
+	
+	// Returns: if the parameters differ in number, type or value.
+	bool operator!=(const CplexParameter& parameter) const;
+};
+
+// This class represents a set of CPLEX parameters already resolved to their numbers and types, so they can be applied
+// to an environment without parsing a json configuration or looking up parameter names.
+// Parameters not included in the configuration have their default values.
+// Invariant: parameters are sorted by number and each number appears at most once.
+class CplexConfiguration
+{
+public:
+	// Creates a configuration with all parameters in their default values.
+	CplexConfiguration() = default;
+	
+	// Compiles the json configuration, where keys are CPLEX parameter names (e.g. "CPX_PARAM_THREADS").
+	// env: CPLEX environment used to look up the parameter names.
+	CplexConfiguration(CPXENVptr env, const nlohmann::json& config);
+	
+	// Sets the value of an int parameter (it replaces the previous value if it was already set).
+	void SetIntParameter(int number, CPXINT value);
+	
+	// Sets the value of a double parameter (it replaces the previous value if it was already set).
+	void SetDoubleParameter(int number, double value);
+	
+	// Returns: the parameters sorted by number.
+	const std::vector<CplexParameter>& Parameters() const;
+	
+	// Applies this configuration to the environment, which currently has the configuration 'applied'.
+	// Only the parameters that differ from 'applied' are sent to CPLEX. The environment is only reset to the
+	// default values if 'applied' has some parameter that is not part of this configuration.
+	// Postcondition: *applied is equal to this configuration.
+	void Apply(CPXENVptr env, CplexConfiguration* applied) const;
+	
+private:
+	// Adds the parameter to the configuration (it replaces the previous value if it was already set).
+	void SetParameter(const CplexParameter& parameter);
+	
+	std::vector<CplexParameter> parameters_; // parameters sorted by number.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_CPLEX_CPLEX_CONFIGURATION_H
@@ -11,6 +11,8 @@
 #include <string>
 #include <memory>
 
+#include "goc/collection/object_pool.h"
+#include "goc/linear_programming/cplex/cplex_configuration.h"
 #include "goc/linear_programming/cplex/cplex_wrapper.h"
 #include "goc/linear_programming/model/constraint.h"
 #include "goc/linear_programming/model/expression.h"
@@ -33,10 +35,25 @@ public:
 	// Returns: the index of the constraint added.
 	virtual int AddConstraint(const Constraint& constraint);
 	
+	// Adds all the constraints to the formulation at once.
+	// Returns: the pair (first, last) with the indices of the first and last constraints added.
+	// Observation: if no constraints are given, then first = ConstraintCount() and last = first-1.
+	virtual std::pair<int, int> AddConstraints(const std::vector<Constraint>& constraints);
+	
+	// Adds all the rows built in 'rows' to the formulation at once.
+	// Returns: the pair (first, last) with the indices of the first and last constraints added.
+	// Observation: if no rows are given, then first = ConstraintCount() and last = first-1.
+	virtual std::pair<int, int> AddConstraints(const RowBuilder& rows);
+	
 	// Removes the constraint with index 'constraint_index' from the formulation.
 	// If such constraint does not exists, it does nothing.
 	virtual void RemoveConstraint(int constraint_index);
 	
+	// Removes all the constraints with indices in 'constraint_indices' from the formulation at once.
+	// The remaining constraints keep their relative order and are renumbered consecutively.
+	// Observation: indices out of range are ignored.
+	virtual void RemoveConstraints(const std::vector<int>& constraint_indices);
+	
 	// Adds a lazy constraint to the model. When a solution is found by the solver, it tries to add some lazy
 	// constraint that separates that solution from the actual solution space.
 	// Observation: if lazy_constraint == nullptr, the call to the function is ignored.
@@ -50,10 +67,20 @@ public:
 	// Returns: a Variable with its correspondent name and index in the formulation.
 	virtual Variable AddVariable(const std::string& name, VariableDomain domain, double lower_bound, double upper_bound);
 	
+	// Adds all the columns built in 'columns' to the model at once, with their coefficients in the objective function
+	// and in the existing constraints.
+	// Returns: the variables added, in the same order as the columns.
+	virtual std::vector<Variable> AddColumns(const ColumnBuilder& columns);
+	
 	// Removes the variable with the same index than the one given as a parameter.
 	// Observation: The name is ignored.
 	virtual void RemoveVariable(const Variable& variable);
 	
+	// Removes all the variables from the formulation at once.
+	// The remaining variables keep their relative order and are renumbered consecutively.
+	// Observation: the variables removed become invalid.
+	virtual void RemoveVariables(const std::vector<Variable>& variables);
+	
 	// Sets the domain of the variable in the model. Domain might be Real, Integer, or Binary.
 	virtual void SetVariableDomain(const Variable& variable, VariableDomain domain);
 	
@@ -112,6 +139,12 @@ public:
 	// Returns: a sequence with all the constraints.
 	virtual std::vector<Constraint> Constraints() const;
 	
+	// Appends the columns of the variables (coefficients, name, objective coefficient, domain and bounds) to columns.
+	virtual void GetColumns(const std::vector<Variable>& variables, ColumnBuilder* columns) const;
+	
+	// Appends every constraint to rows with its sense and right hand side but no terms.
+	virtual void GetEmptyRows(RowBuilder* rows) const;
+	
 	// Returns: a sequence with all the lazy constraints.
 	virtual const std::vector<SeparationRoutine*>& LazyConstraints() const;
 	
@@ -142,17 +175,29 @@ public:
 	
 	CPXLPptr Problem() const;
 	
+	// Returns: a CPLEX problem with the continuous relaxation of the formulation, to be solved with lpopt.
+	// If the problem is an LP, then it is the problem itself. Otherwise, a continuous clone of the problem is created
+	// the first time and it is kept in sync with every later modification of the formulation. This way repeated
+	// solves do not change the problem type back and forth, and CPLEX warm starts them from the previous basis.
+	CPXLPptr Relaxation();
+	
+	// Returns: the configuration currently applied to the CPLEX environment.
+	// Observation: it is shared by all the copies of the formulation, since they share the environment.
+	CplexConfiguration* AppliedConfiguration() const;
+	
 private:
 	// Constructor for the case when an environment and problem were already existing.
-	CplexFormulation(const std::shared_ptr<cpxenv>& env_memory_handler, CPXLPptr problem);
+	CplexFormulation(const std::shared_ptr<cpxenv>& env_memory_handler,
+		const std::shared_ptr<CplexConfiguration>& applied_configuration, CPXLPptr problem);
 	
 	std::shared_ptr<cpxenv> env_memory_handler_; // This shared pointer will free the environment if no more
 													// references are alive. This is necessary in case of a problem copy.
 	CPXENVptr env_; // CPLEX environment.
+	std::shared_ptr<CplexConfiguration> applied_configuration_; // parameters currently set in the environment.
 	CPXLPptr problem_; // CPLEX problem.
-	std::vector<std::string> variable_names_; // Need to keep names because CPLEX keeps pointer to them.
-	std::vector<int*> variable_indices_; // CPLEX indices of the variables in the variables_ vector.
-	std::vector<int*> constraint_indices_; // CPLEX indices of the constraints in the constraints_ vector.
+	CPXLPptr relaxation_; // continuous clone of the CPLEX problem (nullptr if it was not needed yet).
+	ObjectPool<VariableEntry> entry_pool_; // memory of the variable entries.
+	std::vector<VariableEntry*> variable_entries_; // variable_entries_[i] is the entry (index and name) of the i-th column.
 	std::vector<SeparationRoutine*> lazy_constraints_; // lazy constraints of the model.
 };
 } // namespace goc
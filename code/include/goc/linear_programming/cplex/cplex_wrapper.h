@@ -9,6 +9,8 @@
 
 #include "ilcplex/cplex.h"
 
+#include "goc/linear_programming/model/constraint.h"
+
 namespace goc
 {
 namespace cplex
@@ -24,8 +26,13 @@ void freeprob(CPXENVptr env, CPXLPptr* lp_p);
 void newcols(CPXENVptr env, CPXLPptr lp, int ccnt, double const* obj, double const* lb,
 					double const* ub, char const* xctype, char** colname);
 
+void addcols(CPXENVptr env, CPXLPptr lp, int ccnt, int nzcnt, double const* obj, int const* cmatbeg,
+			 int const* cmatind, double const* cmatval, double const* lb, double const* ub, char** colname);
+
 void delcols(CPXCENVptr env, CPXLPptr lp, int begin, int end);
 
+void delsetcols(CPXENVptr env, CPXLPptr lp, int* delstat);
+
 void chgctype(CPXENVptr env, CPXLPptr lp, int cnt, int const* indices, char const* xctype);
 
 void getctype(CPXENVptr env, CPXCLPptr lp, char* xctype, int begin, int end);
@@ -64,6 +71,8 @@ void chgobjsen(CPXENVptr env, CPXLPptr lp, int maxormin);
 
 void delrows(CPXENVptr env, CPXLPptr lp, int begin, int end);
 
+void delsetrows(CPXENVptr env, CPXLPptr lp, int* delstat);
+
 CPXLPptr cloneprob(CPXENVptr env, CPXCLPptr lp);
 
 void mipopt(CPXENVptr env, CPXLPptr lp);
@@ -94,6 +103,9 @@ void getsense(CPXCENVptr env, CPXCLPptr lp, char* sense, int begin, int end);
 void getrows(CPXCENVptr env, CPXCLPptr lp, int* nzcnt_p, int* rmatbeg, int* rmatind, double* rmatval,
 			 int rmatspace, int* surplus_p, int begin, int end);
 
+void getcols(CPXCENVptr env, CPXCLPptr lp, int* nzcnt_p, int* cmatbeg, int* cmatind, double* cmatval,
+			 int cmatspace, int* surplus_p, int begin, int end);
+
 void setintparam(CPXENVptr env, int whichparam, CPXINT newvalue);
 
 void setdblparam(CPXENVptr env, int whichparam, double newvalue);
@@ -156,6 +168,8 @@ int getnumrows(CPXENVptr env, CPXCLPptr lp);
 
 int getnumcols(CPXENVptr env, CPXCLPptr lp);
 
+int getnumnz(CPXENVptr env, CPXCLPptr lp);
+
 void copyorder(CPXENVptr env, CPXLPptr lp, int cnt, int const* indices, int const* priority,
 					  int const* direction);
 
@@ -216,6 +230,9 @@ void callbackgetinfodbl(CPXCALLBACKCONTEXTptr context, CPXCALLBACKINFO what, dou
 void copybase(CPXCENVptr env, CPXLPptr lp, int const* cstat, int const* rstat);
 
 void getbase(CPXCENVptr env, CPXCLPptr lp, int* cstat, int* rstat);
+
+// Returns: the CPLEX character representing the sense of a constraint ('L', 'G' or 'E').
+char sense(enum Constraint::Sense sense);
 } // namespace cplex
 } // namespace goc
 
@@ -0,0 +1,79 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_CUTS_CUT_POOL_H
+#define GOC_LINEAR_PROGRAMMING_CUTS_CUT_POOL_H
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "goc/linear_programming/model/constraint.h"
+#include "goc/linear_programming/model/dense_valuation.h"
+#include "goc/linear_programming/model/valuation.h"
+
+namespace goc
+{
+// This class keeps the cuts found by the separation routines, so they can be checked against later relaxation points
+// before calling the routines again. Cuts are deduplicated by hashing their terms, sense and right hand side.
+// Each time the pool is checked, cuts that are not violated get one unit older and violated cuts become young again.
+// Cuts older than the age limit are removed from the pool.
+// Observation: all methods can be called concurrently. Many threads can check the pool at the same time (ages are
+// atomic), old cuts are removed afterwards by a single thread, and only Add, Clear and that removal block the others.
+class CutPool
+{
+public:
+	// age_limit: number of consecutive checks a cut can stay not violated before it is removed from the pool.
+	explicit CutPool(int age_limit);
+	
+	// Adds the cut to the pool.
+	// Returns: true if it was added, false if an equal cut was already in the pool.
+	bool Add(const Constraint& cut);
+	
+	// Returns: the cuts in the pool violated by 'solution' (at most 'count_limit'), and ages the rest.
+	std::vector<Constraint> Separate(const Valuation& solution, int count_limit);
+	
+	// Returns: the cuts in the pool violated by 'solution' (at most 'count_limit'), and ages the rest.
+	std::vector<Constraint> Separate(const ValuationView& solution, int count_limit);
+	
+	// Returns: the number of cuts in the pool.
+	int Size() const;
+	
+	// Removes all the cuts from the pool.
+	void Clear();
+	
+private:
+	// A cut in the pool.
+	struct Entry
+	{
+		Constraint cut; // the inequality.
+		size_t hash; // hash of the cut.
+		std::atomic<int> age; // number of consecutive checks where the cut was not violated.
+		
+		Entry(const Constraint& cut, size_t hash);
+		
+		Entry(Entry&& entry);
+		
+		Entry& operator=(Entry&& entry);
+	};
+	
+	// Returns: the violated cuts (ValuationType is Valuation or ValuationView).
+	template<typename ValuationType>
+	std::vector<Constraint> SeparateSolution(const ValuationType& solution, int count_limit);
+	
+	// Removes the cuts older than the age limit.
+	void RemoveOldCuts();
+	
+	int age_limit_; // maximum age of a cut in the pool.
+	mutable std::shared_timed_mutex lock_; // entries are only read (and aged) with a shared lock.
+	std::vector<Entry> entries_; // cuts in the pool.
+	std::unordered_multimap<size_t, int> index_; // positions in entries_ of the cuts with each hash.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_CUTS_CUT_POOL_H
@@ -7,20 +7,32 @@
 #ifndef GOC_LINEAR_PROGRAMMING_CUTS_SEPARATION_ALGORITHM_H
 #define GOC_LINEAR_PROGRAMMING_CUTS_SEPARATION_ALGORITHM_H
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "goc/concurrency/thread_pool.h"
+#include "goc/linear_programming/cuts/cut_pool.h"
+#include "goc/linear_programming/cuts/separation_routine_executor.h"
 #include "goc/linear_programming/cuts/separation_strategy.h"
 #include "goc/linear_programming/model/constraint.h"
+#include "goc/linear_programming/model/dense_valuation.h"
 #include "goc/time/duration.h"
 
 namespace goc
 {
 // This class is responsible for executing a separation strategy on a branch and cut algorithm.
 // It also keeps track of the cuts added and time spent for statistics.
+// The cuts found by each routine are ranked by efficacy (violation divided by the norm of the cut), and the best ones
+// are kept up to the cuts per iteration, skipping those too parallel to the cuts already selected in the iteration.
+// Separate can be called concurrently (e.g. from the callbacks of a parallel branch and cut). Statistics are kept in
+// atomic counters, and the cut and iteration limits are enforced by reserving cuts and iterations before using them.
+// Routines declared as Serialized are never executed concurrently, Cloneable routines are cloned for each thread.
+// Families with no dependencies among them are separated at the same time on a thread pool when the strategy asks for
+// more than one thread. Cuts are selected in family order after each dependency level, so results are deterministic.
 class SeparationAlgorithm
 {
 public:
@@ -34,6 +46,13 @@ public:
 	// Returns: the violated constraints found.
 	std::vector<Constraint> Separate(const Valuation& solution, int node_number, double node_bound) const;
 	
+	// Separates the dense solution using the separation strategy.
+	// solution: current fractional solution that has to be cut (indexed by variable index).
+	// node_number: node in the BB tree enumeration (0 is root).
+	// node_bound: bound of the current node in the BB tree.
+	// Returns: the violated constraints found.
+	std::vector<Constraint> Separate(const ValuationView& solution, int node_number, double node_bound) const;
+	
 	// Returns: true if there is at least one cut family which can be executed for separation according to the
 	// separation strategy. If all families stopped separating because of their limits, then it returns false.
 	bool IsEnabled() const;
@@ -44,6 +63,12 @@ public:
 	// Returns: the total number of cuts from the family added.
 	int CutsAdded(const std::string& family) const;
 	
+	// Returns: if cuts are kept in a cut pool (they should be added as purgeable, since the pool can add them again).
+	bool UsesCutPool() const;
+	
+	// Returns: the total number of cuts taken from the cut pool.
+	int CutsFromPool() const;
+	
 	// Returns: the total number of cut iterations performed.
 	int IterationCount() const;
 	
@@ -63,21 +88,45 @@ public:
 	void Disable() const;
 	
 private:
-	// Limit of cuts for a given family in the current iteration.
-	int CutLimitForThisIteration(const std::string& family, double node_bound) const;
+	// Separates the solution using the separation strategy (ValuationType is Valuation or ValuationView).
+	template<typename ValuationType>
+	std::vector<Constraint> SeparateSolution(const ValuationType& solution, int node_number, double node_bound) const;
+	
+	// Statistics and limits state of a cut family. They are atomic so many threads can separate at the same time.
+	struct FamilyState
+	{
+		std::atomic<int> cuts_added; // number of cuts added.
+		std::atomic<int> iteration_count; // number of iterations run.
+		std::atomic<double> separation_time; // time spent on separation (in milliseconds).
+		std::atomic<bool> disabled; // if the family reached some of the limits and will never separate a cut again.
+	};
+	
+	// Limit of cuts for the family in position 'family_index' in the current iteration.
+	int CutLimitForThisIteration(int family_index, double node_bound) const;
+	
+	// Disables the family in position 'family_index' from future separations.
+	void DisableFamily(int family_index) const;
 	
-	mutable std::mutex lock_; 	// This lock is important for parallel branch and bound execution.
-							 	// It makes sure only one separation routine is called at each time.
-							 	
 	SeparationStrategy strategy_; // Strategy to be used.
 	std::vector<std::string> families_ordered_by_dependencies_; // Families in topological order by '<': "depends on".
+	std::unordered_map<std::string, int> family_index_; // position of each family in families_ordered_by_dependencies_.
+	std::vector<std::vector<int>> dependency_levels_; // positions of the families grouped by the level of dependency.
+	std::unique_ptr<ThreadPool> thread_pool_; // threads to separate families of a level (nullptr if sequential).
+	
+	// Calls the routines respecting their concurrency support, so routines that are not thread safe never run
+	// concurrently, while different routines (and stateless or cloneable ones) can run in parallel.
+	SeparationRoutineExecutor executor_;
+	
+	// cut_pools_[i] has the cuts found so far of the family families_ordered_by_dependencies_[i] (empty if the
+	// strategy does not use a pool).
+	std::vector<std::unique_ptr<CutPool>> cut_pools_;
 	
 	// Keep track of what happened so far.
-	mutable double last_objective_; // last objective value recorded.
-	mutable std::unordered_map<std::string, int> cuts_added_, iteration_count_; // cuts added and number of iterations run.
-	mutable std::unordered_map<std::string, Duration> separation_time_; // Time spent on separation of each family.
-	mutable std::unordered_set<std::string> disabled_families_; // families that reached some of the limits and will never separate a cut in the future.
-	mutable bool is_disabled_; // True if the algorithm is disabled, false otherwise.
+	mutable std::atomic<int> cuts_from_pool_; // number of cuts taken from the pool.
+	mutable std::vector<std::unique_ptr<FamilyState>> family_states_; // state of each family (same order as families).
+	mutable std::atomic<int> disabled_family_count_; // number of families disabled.
+	mutable std::atomic<double> last_objective_; // last objective value recorded.
+	mutable std::atomic<bool> is_disabled_; // True if the algorithm is disabled, false otherwise.
 };
 } // namespace goc
 
@@ -10,15 +10,36 @@
 #include <list>
 
 #include "goc/linear_programming/model/constraint.h"
+#include "goc/linear_programming/model/dense_valuation.h"
 #include "goc/linear_programming/model/valuation.h"
 
 namespace goc
 {
 // This is a base class for all separation routines (cuts and lazy constraints).
 // All implemented routines should implement this interface in order to be used in a SeparationAlgorithm.
+// Routines must override at least one of the Separate methods. Solvers call the ValuationView version, which by
+// default converts the solution to a Valuation; routines that override it avoid that conversion.
+// Views passed by the solvers carry their support, so routines can traverse only the non-zero values.
 class SeparationRoutine
 {
 public:
+	// Declares how the routine may be called from several threads at the same time (e.g. parallel branch and cut).
+	// - Serialized: the routine is not thread safe, the separation algorithm never runs two calls at the same time.
+	// - Stateless: Separate does not modify shared state, so it can run concurrently on many threads.
+	// - Cloneable: Separate modifies the state of the routine, but each thread can use its own copy (see Clone).
+	enum class Concurrency { Serialized, Stateless, Cloneable };
+	
+	virtual ~SeparationRoutine() = default;
+	
+	// Returns: how the routine may be called concurrently.
+	// Observation: the default implementation returns Serialized.
+	virtual Concurrency ConcurrencySupport() const;
+	
+	// Returns: a copy of the routine that can separate independently from this one (the caller owns it).
+	// Precondition: ConcurrencySupport() is Cloneable.
+	// Observation: the default implementation fails, Cloneable routines must override it.
+	virtual SeparationRoutine* Clone() const;
+	
 	// Separates the current 'solution' by generating up to 'count_limit' violated cuts.
 	// solution: solution to be separated from the model.
 	// node_number: number of node in the BB tree (0 is root).
@@ -27,7 +48,18 @@ public:
 	// node_bound: bound of the current node.
 	// Returns: a sequence of cuts to add to the formulation.
 	virtual std::vector<Constraint> Separate(const Valuation& solution, int node_number, int count_limit,
-		double node_bound) const = 0;
+		double node_bound) const;
+	
+	// Separates the current 'solution' by generating up to 'count_limit' violated cuts.
+	// solution: dense solution to be separated from the model (indexed by variable index).
+	// node_number: number of node in the BB tree (0 is root).
+	// count_limit: soft limit of the number of cuts that should be generated. The routine can return more and
+	//				the separation algorithm will then decide which to add.
+	// node_bound: bound of the current node.
+	// Returns: a sequence of cuts to add to the formulation.
+	// Observation: the default implementation calls the Valuation version with solution.ToValuation().
+	virtual std::vector<Constraint> Separate(const ValuationView& solution, int node_number, int count_limit,
+		double node_bound) const;
 };
 } // namespace goc
 
@@ -0,0 +1,59 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_CUTS_SEPARATION_ROUTINE_EXECUTOR_H
+#define GOC_LINEAR_PROGRAMMING_CUTS_SEPARATION_ROUTINE_EXECUTOR_H
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "goc/linear_programming/cuts/separation_routine.h"
+
+namespace goc
+{
+// This class calls separation routines from many threads at the same time respecting their concurrency support.
+// - Stateless routines are called directly.
+// - Cloneable routines are cloned the first time a thread uses them, and each thread calls its own clone.
+// - Serialized routines are called holding a lock of the routine, so different routines can still run in parallel.
+// Clones are owned by the executor and destroyed with it.
+class SeparationRoutineExecutor
+{
+public:
+	// Creates an executor for the routines.
+	explicit SeparationRoutineExecutor(const std::vector<const SeparationRoutine*>& routines);
+	
+	// Calls routine->Separate(solution, node_number, count_limit, node_bound) respecting its concurrency support.
+	// Precondition: routine was included when creating the executor.
+	// Returns: the cuts found by the routine.
+	std::vector<Constraint> Separate(const SeparationRoutine* routine, const Valuation& solution, int node_number,
+		int count_limit, double node_bound) const;
+	
+	// Calls routine->Separate(solution, node_number, count_limit, node_bound) respecting its concurrency support.
+	// Precondition: routine was included when creating the executor.
+	// Returns: the cuts found by the routine.
+	std::vector<Constraint> Separate(const SeparationRoutine* routine, const ValuationView& solution, int node_number,
+		int count_limit, double node_bound) const;
+	
+private:
+	// Calls the routine respecting its concurrency support (ValuationType is Valuation or ValuationView).
+	template<typename ValuationType>
+	std::vector<Constraint> SeparateSolution(const SeparationRoutine* routine, const ValuationType& solution,
+		int node_number, int count_limit, double node_bound) const;
+	
+	// Returns: the clone of the routine to be used by the current thread.
+	const SeparationRoutine* CloneFor(const SeparationRoutine* routine) const;
+	
+	std::unordered_map<const SeparationRoutine*, std::unique_ptr<std::mutex>> routine_locks_; // of Serialized routines.
+	mutable std::mutex clones_lock_; // guards clones_.
+	mutable std::unordered_map<std::thread::id,
+		std::unordered_map<const SeparationRoutine*, std::unique_ptr<SeparationRoutine>>> clones_; // clones of each thread.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_CUTS_SEPARATION_ROUTINE_EXECUTOR_H
@@ -26,6 +26,12 @@ namespace goc
 //	- cuts_per_iteration: maximum number of cuts to add per iteration.
 //	- node_limit: maximum number of nodes where this family is separated.
 //	- dependencies: families which must not find a cut in order to search for this family.
+//	- max_parallelism: cuts whose parallelism (cosine of the angle) with a cut already selected in the iteration is
+//	  bigger than this value are discarded (1.0 keeps all of them).
+// And for all families together
+//	- cut_pool_age_limit: if positive, cuts found are kept in a cut pool that is checked before calling the routines.
+//	  Cuts not violated in this many consecutive checks are removed from the pool (0 disables the pool).
+//	- thread_count: number of threads used to run the families with no dependencies among them at the same time.
 // Example:
 // {
 // 		"families": ["sec", "clique"],
@@ -65,8 +71,9 @@ public:
 	const std::vector<std::string>& Dependencies(const std::string& f1) const;
 	
 	// Prints the strategy.
-	// Format: a json object with keys {families, cut_limit, iteration_limit, cuts_per_iteration, node_limit, dependencies}.
-	// {cut_limit, iteration_limit, cuts_per_iteration, node_limit} are strings "f1:num1, f2:num2, ..." where fi is the
+	// Format: a json object with keys {families, cut_limit, iteration_limit, cuts_per_iteration, node_limit, dependencies,
+	//	improvement, max_parallelism, cut_pool_age_limit, thread_count}.
+	// {cut_limit, iteration_limit, cuts_per_iteration, node_limit, improvement, max_parallelism} are strings "f1:num1, f2:num2, ..." where fi is the
 	// 	family and numi is the limit. If fi == "*" then all families are affected.
 	// 	dependencies is a string "f1<f2,f3<f4,...,fk<fk+1" with all the dependencies. fi<fj is fi depends on fj.
 	virtual void Print(std::ostream& os) const;
@@ -76,6 +83,9 @@ public:
 	std::unordered_map<std::string, int> cuts_per_iteration; // maximum number of cuts to add per iteration for a family.
 	std::unordered_map<std::string, int> node_limit; // maximum number of nodes where cuts will be searched for a family.
 	std::unordered_map<std::string, double> improvement; // cuts will be searched if the objective value improved at least this value in the last iteration.
+	std::unordered_map<std::string, double> max_parallelism; // maximum parallelism of a cut with the cuts selected in the iteration.
+	int cut_pool_age_limit; // checks a pooled cut can stay not violated before leaving the pool (0: no cut pool).
+	int thread_count; // threads used to separate independent families at the same time (1: sequential).
 	
 private:
 	std::unordered_map<std::string, const SeparationRoutine*> routines_; // one separation routine associated to each cut family.
@@ -0,0 +1,104 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_MODEL_COLUMN_BUILDER_H
+#define GOC_LINEAR_PROGRAMMING_MODEL_COLUMN_BUILDER_H
+
+#include <string>
+#include <vector>
+
+#include "goc/linear_programming/model/variable.h"
+#include "goc/math/number_utils.h"
+
+namespace goc
+{
+// This class stores a block of columns (new variables) in compressed sparse column format (CSC), so they can be added
+// to a formulation at once with a single call to Formulation::AddColumns.
+// Each column is built by adding its coefficients in the constraints and then closing it with its name, objective
+// coefficient, domain and bounds.
+// Example:
+//	ColumnBuilder columns;
+//	columns.AddTerm(0, 1.0).AddTerm(3, 1.0).EndColumn("y_7", 1.0); // y_7 with cost 1 in constraints 0 and 3.
+//	vector<Variable> y = formulation->AddColumns(columns);
+// Invariant: the terms of column j are in positions [ColumnBegin()[j], ColumnBegin()[j+1]) of RowIndices() and
+// Values(), where ColumnBegin()[ColumnCount()] is taken as NonZeroCount().
+class ColumnBuilder
+{
+public:
+	// Creates an empty block of columns.
+	ColumnBuilder();
+	
+	// Reserves space for 'column_count' columns with 'nonzero_count' terms in total.
+	void Reserve(int column_count, int nonzero_count);
+	
+	// Adds the coefficient of the column being built in the constraint with index 'constraint_index'.
+	// Precondition: each constraint appears at most once in a column.
+	// Returns: a reference to this object to concatenate calls.
+	ColumnBuilder& AddTerm(int constraint_index, double coefficient);
+	
+	// Closes the column being built with the given name, objective coefficient, domain and bounds.
+	// Observation: use -INFTY or INFTY constants to specify no bounds.
+	// Returns: a reference to this object to concatenate calls.
+	ColumnBuilder& EndColumn(const std::string& name, double objective_coefficient,
+		VariableDomain domain=VariableDomain::Real, double lower_bound=0.0, double upper_bound=INFTY);
+	
+	// Appends all the closed columns of 'columns' at the end of this block.
+	// Precondition: there is no column being built (i.e. no terms were added since the last call to EndColumn).
+	// Returns: a reference to this object to concatenate calls.
+	ColumnBuilder& AddColumns(const ColumnBuilder& columns);
+	
+	// Removes the columns j with is_removed[j] = true, keeping the order of the rest.
+	// Precondition: there is no column being built.
+	// Observation: it is done in place, without reallocating the arrays nor copying the names.
+	void RemoveColumns(const std::vector<bool>& is_removed);
+	
+	// Removes all the columns.
+	void Clear();
+	
+	// Returns: the number of columns closed.
+	int ColumnCount() const;
+	
+	// Returns: the number of terms in the closed columns.
+	int NonZeroCount() const;
+	
+	// Returns: the position in RowIndices() and Values() of the first term of each column.
+	const std::vector<int>& ColumnBegin() const;
+	
+	// Returns: the constraint index of each term.
+	const std::vector<int>& RowIndices() const;
+	
+	// Returns: the coefficient of each term.
+	const std::vector<double>& Values() const;
+	
+	// Returns: the name of each column.
+	const std::vector<std::string>& Names() const;
+	
+	// Returns: the objective coefficient of each column.
+	const std::vector<double>& ObjectiveCoefficients() const;
+	
+	// Returns: the domain of each column.
+	const std::vector<VariableDomain>& Domains() const;
+	
+	// Returns: the lower bound of each column.
+	const std::vector<double>& LowerBounds() const;
+	
+	// Returns: the upper bound of each column.
+	const std::vector<double>& UpperBounds() const;
+	
+private:
+	std::vector<int> column_begin_; // column_begin_[j] is the position of the first term of column j.
+	std::vector<int> row_indices_; // constraint index of each term.
+	std::vector<double> values_; // coefficient of each term.
+	std::vector<std::string> names_; // name of each column.
+	std::vector<double> objective_coefficients_; // objective coefficient of each column.
+	std::vector<VariableDomain> domains_; // domain of each column.
+	std::vector<double> lower_bounds_; // lower bound of each column.
+	std::vector<double> upper_bounds_; // upper bound of each column.
+	int open_column_begin_; // position of the first term of the column being built.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_MODEL_COLUMN_BUILDER_H
@@ -9,6 +9,7 @@
 
 #include <iostream>
 
+#include "goc/linear_programming/model/dense_valuation.h"
 #include "goc/linear_programming/model/expression.h"
 #include "goc/linear_programming/model/valuation.h"
 #include "goc/print/printable.h"
@@ -38,6 +39,9 @@ public:
 	// Returns: if the constraint holds for valuation v.
 	bool Holds(const Valuation& v) const;
 	
+	// Returns: if the constraint holds for the dense valuation v.
+	bool Holds(const ValuationView& v) const;
+	
 	// Prints the constraint.
 	// Format: left (<=|>=|==) right.
 	virtual void Print(std::ostream& os) const;
@@ -49,6 +53,9 @@ private:
 	// This constructor can only be called from Expression LEQ, GEQ, EQ methods.
 	Constraint(const Expression& left, const Expression& right, enum Sense sense);
 	
+	// Returns: if the constraint holds when its left side evaluates to 'left_value'.
+	bool HoldsFor(double left_value) const;
+	
 	Expression left_side_;
 	double right_side_;
 	enum Sense sense_;
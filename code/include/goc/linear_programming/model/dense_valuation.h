@@ -0,0 +1,129 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_MODEL_DENSE_VALUATION_H
+#define GOC_LINEAR_PROGRAMMING_MODEL_DENSE_VALUATION_H
+
+#include <vector>
+
+#include "goc/linear_programming/model/valuation.h"
+#include "goc/linear_programming/model/variable.h"
+
+namespace goc
+{
+class Formulation;
+
+// A non owning view of a valuation stored as a contiguous array of values indexed by the variable (column) index.
+// It is used to expose the buffers filled by the solvers without copying them or hashing the variables.
+// A view can also carry its support (the sorted indices of the non-zero values), so routines that only look at the
+// non-zero values take time proportional to the support instead of the number of variables.
+// - Invariant: the viewed array (and support) must outlive the view.
+// - Observation: variables with index >= Size() have value 0.
+class ValuationView
+{
+public:
+	// Creates an empty view (all values are 0).
+	ValuationView();
+	
+	// Creates a view of the array values[0..size-1], where values[i] is the value of the variable with index i.
+	// formulation: formulation of the variables, it is only needed to convert the view to a Valuation.
+	// support: sorted indices of the non-zero values (nullptr if it is unknown).
+	ValuationView(const double* values, int size, const Formulation* formulation=nullptr,
+		const std::vector<int>* support=nullptr);
+	
+	// Returns: the value of the variable v.
+	double operator[](const Variable& v) const;
+	
+	// Returns: the value of the variable with index 'variable_index'.
+	double operator[](int variable_index) const;
+	
+	// Returns: the value of the variable v.
+	double at(const Variable& v) const;
+	
+	// Returns: the number of values viewed.
+	int Size() const;
+	
+	// Returns: a pointer to the viewed array.
+	const double* Data() const;
+	
+	// Returns: the formulation of the variables (nullptr if it was not specified).
+	const Formulation* Model() const;
+	
+	// Returns: if the view carries the support of the values.
+	bool HasSupport() const;
+	
+	// Returns: the indices of the non-zero values in increasing order.
+	// Precondition: HasSupport().
+	const std::vector<int>& Support() const;
+	
+	// Returns: if all the values are integer.
+	bool IsInteger() const;
+	
+	// Returns: a valuation with the non-zero values of the view.
+	// Precondition: the view was created with a formulation.
+	Valuation ToValuation() const;
+	
+private:
+	const double* values_; // values_[i] is the value of the variable with index i.
+	int size_; // number of values.
+	const Formulation* formulation_; // formulation of the variables.
+	const std::vector<int>* support_; // indices of the non-zero values (nullptr if unknown).
+};
+
+// Sets support with the indices i of the values[0..size-1] that are not 0 (up to epsilon) in increasing order.
+void build_support(const double* values, int size, std::vector<int>* support);
+
+// A valuation stored as a contiguous array of values indexed by the variable (column) index.
+// Unlike Valuation, all values are stored (including zeros), so it should be used for dense solutions.
+// - Observation: variables with index >= Size() have value 0.
+class DenseValuation
+{
+public:
+	// Creates an empty valuation.
+	DenseValuation();
+	
+	// Creates a valuation for 'size' variables with all values equal to 0.
+	// formulation: formulation of the variables, it is only needed to convert the valuation to a Valuation.
+	explicit DenseValuation(int size, const Formulation* formulation=nullptr);
+	
+	// Creates a valuation where values[i] is the value of the variable with index i.
+	// formulation: formulation of the variables, it is only needed to convert the valuation to a Valuation.
+	explicit DenseValuation(std::vector<double> values, const Formulation* formulation=nullptr);
+	
+	// Sets the value of the variable v.
+	// Observation: the valuation grows if the index of v is not smaller than Size().
+	void SetValue(const Variable& v, double value);
+	
+	// Returns: the value of the variable v.
+	double operator[](const Variable& v) const;
+	
+	// Returns: the value of the variable v.
+	double at(const Variable& v) const;
+	
+	// Returns: the number of values stored.
+	int Size() const;
+	
+	// Returns: a pointer to the values, so solvers can fill them directly.
+	double* Data();
+	
+	// Returns: a view of the valuation.
+	// Observation: the view is invalidated if the valuation grows or is destroyed.
+	ValuationView View() const;
+	
+	// Returns: a view of the valuation.
+	operator ValuationView() const;
+	
+	// Returns: a valuation with the non-zero values.
+	// Precondition: the valuation was created with a formulation.
+	Valuation ToValuation() const;
+	
+private:
+	std::vector<double> values_; // values_[i] is the value of the variable with index i.
+	const Formulation* formulation_; // formulation of the variables.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_MODEL_DENSE_VALUATION_H
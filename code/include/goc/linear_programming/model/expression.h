@@ -8,9 +8,9 @@
 #define GOC_LINEAR_PROGRAMMING_MODEL_EXPRESSION_H
 
 #include <iostream>
-#include <unordered_map>
 #include <vector>
 
+#include "goc/linear_programming/model/dense_valuation.h"
 #include "goc/linear_programming/model/valuation.h"
 #include "goc/linear_programming/model/variable.h"
 #include "goc/print/printable.h"
@@ -25,6 +25,10 @@ class Constraint;
 // Example: 2x + 3y + 5.
 // Invariant: The expression is always normalized. E.g. 2x + 2x is not normalized, 4x is normalized.
 // Invariant: The expression does not have 0 coefficients associated with variables.
+// Terms are stored as two parallel arrays (variables and coefficients) sorted by variable. Adding terms appends them
+// at the end of the arrays, and they are sorted and merged lazily the next time the terms are read.
+// Observation: reading the terms of an expression may normalize its inner arrays, therefore an expression should not be
+// read concurrently from multiple threads unless it is normalized (e.g. left sides of constraints are always normalized).
 class Expression : public Printable
 {
 public:
@@ -106,17 +110,40 @@ public:
 	int NonZeroVariableTermCount() const;
 	
 	// Returns: a sequence with the terms involving variables paired with their coefficients (!= 0).
+	// Observation: it copies the terms, use Variables() and Coefficients() to traverse them without copying.
 	std::vector<std::pair<Variable, double>> Terms() const;
 	
+	// Returns: the variables with non zero coefficient sorted ascendingly.
+	// Observation: Variables()[i] has coefficient Coefficients()[i].
+	const std::vector<Variable>& Variables() const;
+	
+	// Returns: the non zero coefficients of the variables.
+	// Observation: Coefficients()[i] is the coefficient of Variables()[i].
+	const std::vector<double>& Coefficients() const;
+	
 	// Returns: the expression evaluated on the valuation v.
 	double Value(const Valuation& v) const;
 	
+	// Returns: the expression evaluated on the dense valuation v.
+	double Value(const ValuationView& v) const;
+	
 	// Prints the expression to the stream.
 	// Format: c1x1 + c2x2 + ... + cnxn + scalar. (+ scalar if scalar != 0 or n==0).
 	virtual void Print(std::ostream& os) const;
 	
 private:
-	std::unordered_map<Variable, double> coefficients_; // Stores the coefficients of each variable.
+	friend class Constraint;
+	
+	// Sorts the terms appended since the last normalization and merges them with the normalized ones, adding up the
+	// coefficients of repeated variables and removing the terms with 0 coefficient.
+	void Normalize() const;
+	
+	// Appends the term coefficient * variable at the end of the arrays (it is merged in the next normalization).
+	void AppendTerm(const Variable& variable, double coefficient);
+	
+	mutable std::vector<Variable> variables_; // Variables of the terms, variables_[i] has coefficient coefficients_[i].
+	mutable std::vector<double> coefficients_; // Coefficients of the terms.
+	mutable int normalized_count_; // The first normalized_count_ terms are sorted, without repetitions nor 0s.
 	double scalar_; // Stores the scalar of the expression.
 };
 
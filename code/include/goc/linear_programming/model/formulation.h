@@ -12,18 +12,17 @@
 #include <vector>
 
 #include "goc/linear_programming/model/variable.h"
+#include "goc/linear_programming/model/column_builder.h"
 #include "goc/linear_programming/model/valuation.h"
 #include "goc/linear_programming/model/constraint.h"
 #include "goc/linear_programming/model/expression.h"
+#include "goc/linear_programming/model/row_builder.h"
 #include "goc/linear_programming/cuts/separation_routine.h"
 #include "goc/math/number_utils.h"
 #include "goc/print/printable.h"
 
 namespace goc
 {
-// Represents the domain of the variables in a (mixed integer) linear programming model.
-enum class VariableDomain { Real, Integer, Binary };
-
 // Represents a (mixed integer) linear programming model.
 // It is a protocol designed to abstract specific implementations for solvers (CPLEX, Gurobi, etc).
 class Formulation : public Printable
@@ -39,10 +38,25 @@ public:
 	// Returns: the index of the constraint added.
 	virtual int AddConstraint(const Constraint& constraint) = 0;
 	
+	// Adds all the constraints to the formulation at once.
+	// Returns: the pair (first, last) with the indices of the first and last constraints added.
+	// Observation: if no constraints are given, then first = ConstraintCount() and last = first-1.
+	virtual std::pair<int, int> AddConstraints(const std::vector<Constraint>& constraints) = 0;
+	
+	// Adds all the rows built in 'rows' to the formulation at once.
+	// Returns: the pair (first, last) with the indices of the first and last constraints added.
+	// Observation: if no rows are given, then first = ConstraintCount() and last = first-1.
+	virtual std::pair<int, int> AddConstraints(const RowBuilder& rows) = 0;
+	
 	// Removes the constraint with index 'constraint_index' from the formulation.
 	// If such constraint does not exists, it does nothing.
 	virtual void RemoveConstraint(int constraint_index) = 0;
 	
+	// Removes all the constraints with indices in 'constraint_indices' from the formulation at once.
+	// The remaining constraints keep their relative order and are renumbered consecutively.
+	// Observation: indices out of range are ignored.
+	virtual void RemoveConstraints(const std::vector<int>& constraint_indices) = 0;
+	
 	// Adds a lazy constraint to the model. When a solution is found by the solver, it tries to add some lazy
 	// constraint that separates that solution from the actual solution space.
 	// Observation: if lazy_constraint == nullptr, the call to the function is ignored.
@@ -56,10 +70,20 @@ public:
 	// Returns: a Variable with its correspondent name and index in the formulation.
 	virtual Variable AddVariable(const std::string& name, VariableDomain domain=VariableDomain::Real, double lower_bound=-INFTY, double upper_bound=INFTY) = 0;
 	
+	// Adds all the columns built in 'columns' to the model at once, with their coefficients in the objective function
+	// and in the existing constraints.
+	// Returns: the variables added, in the same order as the columns.
+	virtual std::vector<Variable> AddColumns(const ColumnBuilder& columns) = 0;
+	
 	// Removes the variable with the same index than the one given as a parameter.
 	// Observation: The name is ignored.
 	virtual void RemoveVariable(const Variable& variable) = 0;
 	
+	// Removes all the variables from the formulation at once.
+	// The remaining variables keep their relative order and are renumbered consecutively.
+	// Observation: the variables removed become invalid.
+	virtual void RemoveVariables(const std::vector<Variable>& variables) = 0;
+	
 	// Sets the domain of the variable in the model. Domain might be Real, Integer, or Binary.
 	virtual void SetVariableDomain(const Variable& variable, VariableDomain domain) = 0;
 	
@@ -118,6 +142,13 @@ public:
 	// Returns: a sequence with all the constraints.
 	virtual std::vector<Constraint> Constraints() const = 0;
 	
+	// Appends the columns of the variables (coefficients, name, objective coefficient, domain and bounds) to columns.
+	virtual void GetColumns(const std::vector<Variable>& variables, ColumnBuilder* columns) const = 0;
+	
+	// Appends every constraint to rows with its sense and right hand side but no terms, as the terms are part of the
+	// columns. The empty rows and the columns of all the variables can rebuild the formulation elsewhere.
+	virtual void GetEmptyRows(RowBuilder* rows) const = 0;
+	
 	// Returns: a sequence with all the lazy constraints.
 	virtual const std::vector<SeparationRoutine*>& LazyConstraints() const = 0;
 	
@@ -0,0 +1,84 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_MODEL_ROW_BUILDER_H
+#define GOC_LINEAR_PROGRAMMING_MODEL_ROW_BUILDER_H
+
+#include <vector>
+
+#include "goc/linear_programming/model/constraint.h"
+#include "goc/linear_programming/model/variable.h"
+
+namespace goc
+{
+// This class stores a block of constraints in compressed sparse row format (CSR), so they can be added to a
+// formulation at once with a single call to Formulation::AddConstraints.
+// Rows can be built term by term (streaming), which avoids creating an Expression and a Constraint for each row.
+// Example:
+//	RowBuilder rows;
+//	rows.AddTerm(x, 2.0).AddTerm(y, 1.0).EndRow(Constraint::LessEqual, 5.0); // 2x + y <= 5.
+//	rows.AddRow((1.0*x).GEQ(1.0)); // x >= 1.
+//	formulation->AddConstraints(rows);
+// Invariant: the terms of row i are in positions [RowBegin()[i], RowBegin()[i+1]) of ColumnIndices() and Values(),
+// where RowBegin()[RowCount()] is taken as NonZeroCount().
+class RowBuilder
+{
+public:
+	// Creates an empty block of rows.
+	RowBuilder();
+	
+	// Reserves space for 'row_count' rows with 'nonzero_count' terms in total.
+	void Reserve(int row_count, int nonzero_count);
+	
+	// Adds the term coefficient * variable to the row being built.
+	// Precondition: each variable appears at most once in a row.
+	// Returns: a reference to this object to concatenate calls.
+	RowBuilder& AddTerm(const Variable& variable, double coefficient);
+	
+	// Closes the row being built as (terms added) 'sense' right_side.
+	// Returns: a reference to this object to concatenate calls.
+	RowBuilder& EndRow(enum Constraint::Sense sense, double right_side);
+	
+	// Adds the constraint as a new row.
+	// Precondition: there is no row being built (i.e. no terms were added since the last call to EndRow).
+	// Returns: a reference to this object to concatenate calls.
+	RowBuilder& AddRow(const Constraint& constraint);
+	
+	// Removes all the rows.
+	void Clear();
+	
+	// Returns: the number of rows closed.
+	int RowCount() const;
+	
+	// Returns: the number of terms in the closed rows.
+	int NonZeroCount() const;
+	
+	// Returns: the position in ColumnIndices() and Values() of the first term of each row.
+	const std::vector<int>& RowBegin() const;
+	
+	// Returns: the column index of each term.
+	const std::vector<int>& ColumnIndices() const;
+	
+	// Returns: the coefficient of each term.
+	const std::vector<double>& Values() const;
+	
+	// Returns: the right hand side of each row.
+	const std::vector<double>& RightSides() const;
+	
+	// Returns: the sense of each row.
+	const std::vector<enum Constraint::Sense>& Senses() const;
+	
+private:
+	std::vector<int> row_begin_; // row_begin_[i] is the position of the first term of row i.
+	std::vector<int> column_indices_; // column index of each term.
+	std::vector<double> values_; // coefficient of each term.
+	std::vector<double> right_sides_; // right hand side of each row.
+	std::vector<enum Constraint::Sense> senses_; // sense of each row.
+	int open_row_begin_; // position of the first term of the row being built.
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_MODEL_ROW_BUILDER_H
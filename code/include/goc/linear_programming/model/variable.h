@@ -10,17 +10,27 @@
 #include <iostream>
 #include <string>
 
-#include "goc/print/printable.h"
 
 namespace goc
 {
+// Represents the domain of the variables in a (mixed integer) linear programming model.
+enum class VariableDomain { Real, Integer, Binary };
+
+// Entry of a variable in the variable table of a formulation. It keeps the only copy of the variable name and its
+// current index, so Variable objects are just handles to these entries.
+struct VariableEntry
+{
+	int index; // index of the variable in the model (i.e. column index).
+	std::string name; // name of the variable.
+};
+
 // This class represents a variable inside a formulation.
 // We can identify a variable by the index of the column in the formulation.
-class Variable : public Printable
+// Observation: it is a handle to an entry owned by the formulation (trivially copyable), therefore it is only valid
+// while the variable is part of the formulation.
+class Variable
 {
 public:
-	std::string name; // name of the variable.
-	
 	// Default constructor.
 	Variable();
 	
@@ -28,25 +38,28 @@ public:
 	// Observation: It can change if some variables are deleted.
 	int Index() const;
 	
-	// Prints the name of the variable.
-	virtual void Print(std::ostream& os) const;
+	// Returns: the name of the variable.
+	const std::string& Name() const;
 	
-	// Compares the index of the variables.
+	// Compares the entries of the variables.
 	bool operator<(const Variable& v) const;
 	
-	// Compares the index of the variables.
+	// Compares the entries of the variables.
 	bool operator==(const Variable& v) const;
 	
-	// Compares the index of the variables.
+	// Compares the entries of the variables.
 	bool operator!=(const Variable& v) const;
 	
 private:
 	friend class CplexFormulation;
 	friend class std::hash<Variable>;
 	
-	Variable(const std::string& name, int* index);
-	int* index_; // a pointer to an integer that keeps the index of this variable updates with respect to the model.
+	explicit Variable(VariableEntry* entry);
+	VariableEntry* entry_; // entry of the variable in the formulation, it keeps the index updated with respect to the model.
 };
+
+// Prints the name of the variable.
+std::ostream& operator<<(std::ostream& os, const Variable& v);
 } // namespace goc
 
 // Implement hash function in order to use Variable as keys in unordered_map and unordered_set.
@@ -57,7 +70,7 @@ class hash<goc::Variable> {
 public:
 	size_t operator()(const goc::Variable& v) const
 	{
-		return std::hash<int*>()(v.index_);
+		return std::hash<goc::VariableEntry*>()(v.entry_);
 	}
 };
 } // namespace std
@@ -8,6 +8,7 @@
 #define GOC_LINEAR_PROGRAMMING_SOLVER_BC_SOLVER_H
 
 #include <iostream>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -21,6 +22,8 @@
 
 namespace goc
 {
+class CplexConfiguration;
+
 // All the log options that can be enabled/disabled.
 // - ScreenOutput: 		if not included, the output will not be stored.
 //						advantage: saving space.
@@ -44,8 +47,6 @@ public:
 	std::ostream* screen_output;
 	// Maximum time to spend solving.
 	Duration time_limit;
-	// Json object with the configuration options to send to the solver.
-	nlohmann::json config;
 	// Object that indicates what families of cuts will be added and the strategy to do so.
 	SeparationStrategy separation_strategy;
 	// A set of initial solutions for the BC.
@@ -63,8 +64,21 @@ public:
 	// Precondition: the formulation must have been created with the NewFormulation() method.
 	BCExecutionLog Solve(Formulation* formulation, const std::unordered_set<BCOption>& options={}) const;
 	
+	// Sets the json object with the configuration options to send to the solver (keys are CPLEX parameter names).
+	// Observation: it is compiled on the next solve, so it must not be called while the solver is solving.
+	void SetConfig(const nlohmann::json& config);
+	
+	// Returns: the json object with the configuration options to send to the solver.
+	const nlohmann::json& Config() const;
+	
 	// Returns: a formulation compatible with the solver.
 	static Formulation* NewFormulation();
+	
+private:
+	nlohmann::json config_; // configuration options to send to the solver.
+	// config_ compiled by the first solve after it is set (nullptr until then). It is read and written with
+	// std::atomic_load and std::atomic_store, so many threads can solve with the same solver.
+	mutable std::shared_ptr<CplexConfiguration> compiled_config_;
 };
 } // namespace goc
 
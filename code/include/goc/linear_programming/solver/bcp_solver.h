@@ -0,0 +1,112 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#ifndef GOC_LINEAR_PROGRAMMING_SOLVER_BCP_SOLVER_H
+#define GOC_LINEAR_PROGRAMMING_SOLVER_BCP_SOLVER_H
+
+#include <functional>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include "goc/linear_programming/cuts/separation_strategy.h"
+#include "goc/linear_programming/model/formulation.h"
+#include "goc/linear_programming/model/row_builder.h"
+#include "goc/linear_programming/model/valuation.h"
+#include "goc/linear_programming/solver/bc_solver.h"
+#include "goc/linear_programming/solver/cg_solver.h"
+#include "goc/log/bcp_execution_log.h"
+#include "goc/time/duration.h"
+
+namespace goc
+{
+// The decisions that define a child of a node in the branch and price tree. They are expressed with variable indices
+// of the parent master, which are kept by the child since its master is rebuilt from the rows and columns of the parent
+// master in the same order.
+// Observation: pricing functions must respect the decisions. Rows added to the master get duals (after the duals of
+// the previous rows), but bounds on master variables are not seen by the pricing.
+struct BranchingChild
+{
+	RowBuilder rows; // constraints added to the child master.
+	std::vector<int> bounded_variables; // indices of the master variables whose bounds change in the child.
+	std::vector<double> lower_bounds; // lower_bounds[i] is the new lower bound of variable bounded_variables[i].
+	std::vector<double> upper_bounds; // upper_bounds[i] is the new upper bound of variable bounded_variables[i].
+};
+
+// Function type for the branching rule.
+// - master: master formulation of the node.
+// - solution: fractional solution of the master of the node.
+// Returns: the children of the node (if empty, the node is pruned).
+typedef std::function<std::vector<BranchingChild>(const Formulation* master, const Valuation& solution)> BranchingRule;
+
+// Function type to get the pricing oracles of a node (e.g. to make the pricing respect the branching decisions).
+// - master: master formulation of the node (its rows include the ones added by the branching rules).
+// Returns: the pricing oracles used by the column generation of the node.
+typedef std::function<std::vector<PricingOracle>(const Formulation* master)> NodePricingFunction;
+
+// Class representing a solver for branch and price (and cut). Each node of the tree is solved by column generation,
+// followed by rounds of cut separation while violated cuts are found. Nodes are selected by best bound, and each child
+// starts from the rows and columns of the master of its parent, so it is warm started with all the columns generated
+// so far. Open nodes only keep those rows and columns (shared by siblings) and their branching decisions, and their
+// master is built when they are solved.
+class BCPSolver
+{
+public:
+	// Pointer to the stream where the output of the algorithm should go. (nullptr for no output).
+	std::ostream* screen_output;
+	// Maximum time to spend solving.
+	Duration time_limit;
+	// Column generation solver used in each node. Its screen output, time limit and cutoff are set by the solver.
+	CGSolver cg_solver;
+	// Object that indicates what families of cuts will be added to the master and the strategy to do so.
+	// Precondition: it does not use a cut pool (cut_pool_age_limit=0). Cuts are never removed from the masters, and
+	// pooled cuts would refer to the variables of masters of other nodes.
+	SeparationStrategy separation_strategy;
+	// Rule that creates the children of a node whose master solution is fractional.
+	BranchingRule branching_rule;
+	// If set, it gives the pricing oracles of each node instead of the ones in cg_solver.
+	NodePricingFunction node_pricing;
+	// The masters of the nodes other than the root have artificial columns (named artificial+_i and artificial-_i) that
+	// violate row i at this cost per unit, so the branching decisions and the cuts do not make a master infeasible
+	// before the pricing generates the columns that satisfy them. A node whose column generation is optimal using
+	// artificial columns is infeasible.
+	// Precondition: it is bigger than the objective improvement a unit of violation of any row can give (e.g. bigger
+	// than the value of every solution of a set partitioning master with non negative costs).
+	// Observation: the branching rule and node_pricing see the artificial columns, with value 0 in the solutions.
+	double artificial_cost;
+	// Number of threads used to solve nodes at the same time. Each thread keeps its own queue of nodes (ordered by
+	// bound) and steals nodes from the others when it runs out of them. The incumbent is shared, so every thread prunes
+	// with the best solution found so far.
+	// Observation: each thread has its own solver environment, where it builds the masters of the nodes it solves
+	// (including the nodes it steals). With more than one thread, the branching rule, the pricing functions and
+	// node_pricing are called concurrently.
+	int thread_count;
+	// If true, the nodes are solved in rounds of the thread_count best ones, and their results are merged in node
+	// order at the end of each round. The search (and its result) is the same in every run, at the cost of threads
+	// waiting for the slowest node of the round.
+	// Observation: nodes of a round share the limits of the separation strategy, so the search is only reproducible
+	// if those limits are not reached.
+	bool deterministic;
+	
+	// Creates a default branch and price solver (no output, time_limit=Max, no branching rule, no cuts,
+	// 	artificial_cost=10^6, thread_count=1, deterministic=false).
+	BCPSolver();
+	
+	// Solves the formulation.
+	// The root node is solved in the formulation itself, and at the end the columns of the best integer solution
+	// found are added to it if they are not there (columns are identified by their names).
+	// Returns: the execution log with the specified options.
+	// Precondition: the formulation must have been created with the NewFormulation() method.
+	// Precondition: the branching rule must be set.
+	// Precondition: the initial columns of the formulation make it feasible (the root has no artificial columns).
+	BCPExecutionLog Solve(Formulation* formulation, const std::unordered_set<BCOption>& options={}) const;
+	
+	// Returns: a formulation compatible with the solver.
+	static Formulation* NewFormulation();
+};
+} // namespace goc
+
+#endif //GOC_LINEAR_PROGRAMMING_SOLVER_BCP_SOLVER_H
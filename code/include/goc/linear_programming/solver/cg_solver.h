@@ -7,11 +7,13 @@
 #ifndef GOC_LINEAR_PROGRAMMING_SOLVER_CG_SOLVER_H
 #define GOC_LINEAR_PROGRAMMING_SOLVER_CG_SOLVER_H
 
+#include <climits>
 #include <functional>
 #include <iostream>
 #include <unordered_set>
 #include <vector>
 
+#include "goc/linear_programming/model/column_builder.h"
 #include "goc/linear_programming/model/formulation.h"
 #include "goc/linear_programming/solver/lp_solver.h"
 #include "goc/log/cg_execution_log.h"
@@ -26,12 +28,47 @@ namespace goc
 //							advantage: saving space.
 enum class CGOption { IterationsInformation, ScreenOutput };
 
+// The outcome of solving the pricing problem once.
+struct PricingResult
+{
+	ColumnBuilder columns; // columns found by the pricing, the column generation adds them to the master.
+	bool formulation_changed; // true if the pricing added variables or constraints to the master by itself.
+	bool exact; // true if no column has a better reduced cost than best_reduced_cost (e.g. the pricing is optimal).
+	double best_reduced_cost; // best reduced cost found (minimum if minimizing, maximum if maximizing).
+	
+	// Creates a result with no columns, which is not exact and has best_reduced_cost=0.
+	PricingResult();
+	
+	// Returns: if the master changed (columns were found or the formulation changed).
+	bool MasterChanged() const;
+};
+
 // Function type for the pricing solver.
 // - duals: the dual variables of the iteration.
 // - incumbent_value: the value of the lp relaxation.
 // - time_limit: maximum time to execute the pricing algorithm.
 // - execution_log: pointer to the cg execution log to add the iteration log.
-typedef std::function<bool(const std::vector<double>& duals, double incumbent_value, Duration time_limit, CGExecutionLog* cg_execution_log)> PricingFunction;
+// Returns: the columns found and the best reduced cost, which is used to compute the Lagrangian bound.
+typedef std::function<PricingResult(const std::vector<double>& duals, double incumbent_value, Duration time_limit, CGExecutionLog* cg_execution_log)> PricingFunction;
+
+// A pricing algorithm in a hierarchy of pricing algorithms (e.g. from a cheap heuristic to an exact one).
+// Oracles are called by increasing level, and a level is only called if the previous ones did not change the master.
+// Oracles in the same level price independent subproblems (e.g. one per vehicle type) and may run concurrently, so
+// they must not modify the formulation nor shared state.
+// Oracles that are called one after the other receive the column generation log itself. When the oracles of a level
+// run concurrently, each one receives a copy of the log (with the current iteration_count, times, etc. but no
+// iterations). The iterations they add are merged into the column generation log in the order of the oracles, and
+// other changes to the copies are discarded.
+// If every oracle of a level has a convexity bound, an exact pricing of the level gives the Lagrangian bound
+// duals * rhs + sum of convexity_bound * best_reduced_cost over its oracles (only improving reduced costs are counted).
+// Otherwise, CGSolver::convexity_bound is used with the best reduced cost of the level.
+struct PricingOracle
+{
+	std::string name; // name used in the logs.
+	int level; // position in the hierarchy (lower levels are called first).
+	PricingFunction function; // pricing algorithm.
+	double convexity_bound; // upper bound on the sum of the master variables of its subproblem (0: no bound).
+};
 
 // Class representing a solver for column generation. Its purpose is to abstract the
 // specific solver implementations from the algorithms.
@@ -44,12 +81,43 @@ public:
 	Duration time_limit;
 	// Pointer to a solver for the linear relaxation of the lp.
 	goc::LPSolver* lp_solver;
-	// A function that receives the current lp iteration and adds variables to the lp. The column generation will
-	// continue as long as the pricing function adds variables (or constraints) to the lp at a given iteration.
+	// A function that receives the current lp iteration and returns new columns for the lp. The column generation will
+	// continue as long as the pricing function finds columns (or adds constraints) at a given iteration.
 	PricingFunction pricing_function;
+	// Hierarchy of pricing algorithms. If it is not empty, it is used instead of pricing_function.
+	std::vector<PricingOracle> pricing_oracles;
+	// Number of threads used to call the oracles of the same level concurrently.
+	int pricing_thread_count;
+	// Wentges smoothing factor in [0, 1). The pricing function receives the duals alpha * center + (1-alpha) * duals,
+	// where the center is the last priced point that improved the Lagrangian bound (or the last point priced
+	// successfully if there is no Lagrangian bound). If none of the columns found at the smoothed point improves the
+	// master at the LP duals (mispricing), they are discarded and the LP duals are priced. 0 disables smoothing.
+	double smoothing_alpha;
+	// If true, smoothing_alpha is only the initial factor. It is increased after each successful smoothed pricing and
+	// halved after each mispricing.
+	bool automatic_smoothing;
+	// Upper bound on the sum of the master variables (e.g. number of vehicles). If positive, each exact pricing gives
+	// the Lagrangian bound duals * rhs + convexity_bound * best_reduced_cost (assuming master variables are non
+	// negative and have no upper bounds). Oracles with their own convexity bound override it (see PricingOracle).
+	double convexity_bound;
+	// The column generation stops when the relative gap between the lp value and the Lagrangian bound is at most this.
+	double gap_limit;
+	// Value of a known integer solution. The column generation stops when the Lagrangian bound shows the master can
+	// not improve it (INFTY or -INFTY for no cutoff).
+	double cutoff;
+	// If positive, columns added by the column generation whose reduced cost does not improve the master for this many
+	// consecutive iterations are removed from the lp into a column pool. Pooled columns are priced at the LP duals
+	// before calling the pricing function (even when smoothing), and added back if they improve the master. 0 disables
+	// the pool.
+	// Observation: removed variables are invalidated and re-added ones get new indices, so columns should be
+	// identified by their names when the pool is used.
+	int column_age_limit;
+	// Maximum number of pooled columns added back to the lp in an iteration (the ones with the best reduced costs).
+	int pool_extract_limit;
 	
 	// Creates a default column generation solver (no output, time_limit=2hs, lp_solver=CPLEX,
-	// 	pricing_function=DONOTHING).
+	// 	pricing_function=DONOTHING, smoothing_alpha=0, automatic_smoothing=false, convexity_bound=0, gap_limit=0,
+	//	cutoff=INFTY, column_age_limit=0, pool_extract_limit=INT_MAX, pricing_thread_count=1).
 	CGSolver();
 	
 	// Solves the formulation using a column generation procedure.
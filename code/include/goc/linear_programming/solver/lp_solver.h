@@ -8,6 +8,7 @@
 #define GOC_LINEAR_PROGRAMMING_SOLVER_LP_SOLVER_H
 
 #include <iostream>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -18,6 +19,8 @@
 
 namespace goc
 {
+class CplexConfiguration;
+
 // All the log options that can be enabled/disabled.
 // - ScreenOutput: 	if not included, the output will not be stored.
 //					advantage: saving space.
@@ -25,7 +28,9 @@ namespace goc
 //					advantage: if model has many constraints, getting them is linear in that size.
 // - Incumbent:		if not included {incumbent} will not be filled.
 //					advantage: if solution has many variables, getting it is linear in that size.
-enum class LPOption { ScreenOutput, Duals, Incumbent };
+// - ReducedCosts:	if not included {reduced_costs} will not be filled.
+//					advantage: if model has many variables, getting them is linear in that size.
+enum class LPOption { ScreenOutput, Duals, Incumbent, ReducedCosts };
 
 // Class representing a solver for the lp relaxation. Its purpose is to abstract the
 // specific solver implementations from the algorithms.
@@ -36,8 +41,6 @@ public:
 	std::ostream* screen_output;
 	// maximum time to spend solving.
 	Duration time_limit;
-	// json object with the configuration options to send to the solver.
-	nlohmann::json config;
 	
 	// Creates a default lp solver. (time limit: 2 hours).
 	// Currently: CPLEX.
@@ -48,8 +51,21 @@ public:
 	// Precondition: the formulation must have been created with the NewFormulation() method.
 	LPExecutionLog Solve(Formulation* formulation, const std::unordered_set<LPOption>& options={}) const;
 	
+	// Sets the json object with the configuration options to send to the solver (keys are CPLEX parameter names).
+	// Observation: it is compiled on the next solve, so it must not be called while the solver is solving.
+	void SetConfig(const nlohmann::json& config);
+	
+	// Returns: the json object with the configuration options to send to the solver.
+	const nlohmann::json& Config() const;
+	
 	// Returns: a formulation compatible with the solver.
 	static Formulation* NewFormulation();
+	
+private:
+	nlohmann::json config_; // configuration options to send to the solver.
+	// config_ compiled by the first solve after it is set (nullptr until then). It is read and written with
+	// std::atomic_load and std::atomic_store, so many threads can solve with the same solver.
+	mutable std::shared_ptr<CplexConfiguration> compiled_config_;
 };
 } // namespace goc
 
@@ -17,8 +17,8 @@
 
 namespace goc
 {
-// All the status that can result from a monodirectional labeling algorithm.
-enum class BLBStatus { DidNotStart, TimeLimitReached, SolutionLimitReached, Finished };
+// All the status that can result from a bidirectional labeling algorithm.
+enum class BLBStatus { DidNotStart, TimeLimitReached, ProcessLimitReached, SolutionLimitReached, Finished };
 
 // This class stores information about the execution of a BIDIRECTIONAL labeling algorithm.
 // It is compatible with the Kaleidoscope kd_type "blb".
@@ -9,6 +9,7 @@
 
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "goc/lib/json.hpp"
@@ -19,7 +20,10 @@
 namespace goc
 {
 // All the status that can result from a column generation execution.
-enum class CGStatus { DidNotStart, Infeasible, Unbounded, TimeLimitReached, MemoryLimitReached, Optimum };
+// - GapLimitReached: the gap between the lp value and the Lagrangian bound is within the limit.
+// - CutoffReached: the Lagrangian bound shows the master can not improve the cutoff value.
+enum class CGStatus { DidNotStart, Infeasible, Unbounded, TimeLimitReached, MemoryLimitReached, Optimum,
+	GapLimitReached, CutoffReached };
 
 // This class stores information about the execution of a column generation algorithm.
 // It is compatible with the Kaleidoscope kd_type "cg".
@@ -32,10 +36,18 @@ public:
 	Valuation incumbent; // best solution found.
 	double incumbent_value; // value of the best solution found.
 	int columns_added; // total number of columns added in the colgen.
+	int columns_removed; // total number of columns moved from the lp to the column pool.
+	int columns_from_pool; // total number of columns added back from the column pool.
+	double lagrangian_bound; // best Lagrangian bound found (-INFTY if minimizing and no bound was found, INFTY if maximizing).
+	std::vector<std::pair<int, double>> bound_trajectory; // (iteration, bound) for each Lagrangian bound computed (improving or not).
 	int iteration_count; // number of pricing iterations solved.
+	int smoothed_pricing_count; // number of pricing calls with smoothed duals.
+	int mispricing_count; // number of pricing calls with smoothed duals whose columns did not improve the LP duals.
 	Duration pricing_time; // time spent solving the pricing problem.
 	Duration lp_time; // time spent solving the lp relaxation.
 	std::vector<nlohmann::json> iterations; // logs of the pricing iterations.
+	std::unordered_map<std::string, Duration> oracle_time; // time spent by each pricing oracle.
+	std::unordered_map<std::string, int> oracle_column_count; // number of columns found by each pricing oracle.
 	
 	CGExecutionLog();
 	
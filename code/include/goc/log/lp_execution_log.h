@@ -34,6 +34,7 @@ public:
 	int variable_count; // number of variables in the lp.
 	int constraint_count; // number of constraints in the lp.
 	std::vector<double> duals; // vector of the dual variables associated to the rows in the solution.
+	std::vector<double> reduced_costs; // vector of the reduced costs of the columns in the solution.
 	
 	LPExecutionLog();
 	
@@ -0,0 +1,90 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/concurrency/thread_pool.h"
+
+using namespace std;
+
+namespace goc
+{
+ThreadPool::ThreadPool(int thread_count) : stopping_(false)
+{
+	for (int i = 1; i < thread_count; ++i) workers_.emplace_back([this] () { Work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> guard(mutex_);
+		stopping_ = true;
+	}
+	has_tasks_.notify_all();
+	for (auto& worker: workers_) worker.join();
+}
+
+void ThreadPool::Run(const vector<function<void()>>& tasks)
+{
+	if (tasks.empty()) return;
+	
+	// Without workers there is nothing to synchronize.
+	if (workers_.empty())
+	{
+		for (auto& task: tasks) task();
+		return;
+	}
+	
+	Batch batch;
+	batch.pending = tasks.size();
+	{
+		lock_guard<mutex> guard(mutex_);
+		for (auto& task: tasks) queue_.push_back({&task, &batch});
+	}
+	has_tasks_.notify_all();
+	
+	// Help executing tasks until the queue is empty, then wait for the workers to finish the rest of the batch.
+	unique_lock<mutex> lock(mutex_);
+	while (batch.pending > 0)
+	{
+		if (queue_.empty())
+		{
+			batch.finished.wait(lock);
+			continue;
+		}
+		Task task = queue_.front();
+		queue_.pop_front();
+		lock.unlock();
+		Execute(task);
+		lock.lock();
+	}
+}
+
+int ThreadPool::ThreadCount() const
+{
+	return workers_.size() + 1;
+}
+
+void ThreadPool::Execute(const Task& task)
+{
+	(*task.function)();
+	lock_guard<mutex> guard(mutex_);
+	if (--task.batch->pending == 0) task.batch->finished.notify_all();
+}
+
+void ThreadPool::Work()
+{
+	unique_lock<mutex> lock(mutex_);
+	while (true)
+	{
+		has_tasks_.wait(lock, [this] () { return stopping_ || !queue_.empty(); });
+		if (queue_.empty()) return;
+		Task task = queue_.front();
+		queue_.pop_front();
+		lock.unlock();
+		Execute(task);
+		lock.lock();
+	}
+}
+} // namespace goc
@@ -35,4 +35,17 @@ bool has_cycle(GraphPath p, int max_size)
 	
 	return false;
 }
+
+bool has_ng_cycle(const GraphPath& p, const vector<VertexSet<>>& ng_neighbourhoods)
+{
+	if (p.empty()) return false;
+	VertexSet<> memory = {p[0]};
+	for (int k = 1; k < p.size(); ++k)
+	{
+		if (memory.Contains(p[k])) return true;
+		memory &= ng_neighbourhoods[p[k]];
+		memory.Insert(p[k]);
+	}
+	return false;
+}
 } // namespace goc
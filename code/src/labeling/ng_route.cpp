@@ -0,0 +1,58 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/labeling/ng_route.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace goc
+{
+vector<VertexSet<>> closest_ng_neighbourhoods(int vertex_count, int size,
+	const function<double(Vertex, Vertex)>& distance)
+{
+	vector<VertexSet<>> neighbourhoods(vertex_count);
+	vector<Vertex> others;
+	for (Vertex v = 0; v < vertex_count; ++v)
+	{
+		others.clear();
+		for (Vertex w = 0; w < vertex_count; ++w) if (w != v) others.push_back(w);
+		int closest_count = max(0, min(size - 1, (int)others.size()));
+		partial_sort(others.begin(), others.begin() + closest_count, others.end(), [&] (Vertex w1, Vertex w2) {
+			return distance(v, w1) < distance(v, w2);
+		});
+		neighbourhoods[v].Insert(v);
+		for (int k = 0; k < closest_count; ++k) neighbourhoods[v].Insert(others[k]);
+	}
+	return neighbourhoods;
+}
+
+bool grow_ng_neighbourhoods(const GraphPath& path, int max_size, vector<VertexSet<>>* ng_neighbourhoods)
+{
+	auto& N = *ng_neighbourhoods;
+	bool changed = false;
+	
+	// last_position[v] is the last position of v in the path visited so far (-1 if it was not visited).
+	vector<int> last_position(N.size(), -1);
+	for (int k = 0; k < path.size(); ++k)
+	{
+		Vertex i = path[k];
+		if (last_position[i] != -1)
+		{
+			// (path[last_position[i]], ..., path[k]) is a cycle on i, add i to the neighbourhoods inside the cycle.
+			for (int l = last_position[i] + 1; l < k; ++l)
+			{
+				if (N[path[l]].Contains(i) || N[path[l]].Count() >= max_size) continue;
+				N[path[l]].Insert(i);
+				changed = true;
+			}
+		}
+		last_position[i] = k;
+	}
+	return changed;
+}
+} // namespace goc
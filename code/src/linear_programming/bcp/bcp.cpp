@@ -0,0 +1,557 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/bcp/bcp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "goc/collection/collection_utils.h"
+#include "goc/concurrency/thread_pool.h"
+#include "goc/exception/exception_utils.h"
+#include "goc/linear_programming/cuts/separation_algorithm.h"
+#include "goc/linear_programming/model/column_builder.h"
+#include "goc/linear_programming/model/row_builder.h"
+#include "goc/math/number_utils.h"
+#include "goc/print/table_stream.h"
+#include "goc/string/string_utils.h"
+#include "goc/time/stopwatch.h"
+
+using namespace std;
+using namespace nlohmann;
+
+namespace goc
+{
+namespace
+{
+// The master of a node saved when it is branched, so its children can be built in any solver environment.
+// Observation: rows are saved without terms, as the terms are part of the columns.
+struct MasterData
+{
+	RowBuilder rows; // constraints of the master (sense and right hand side).
+	ColumnBuilder columns; // columns of all the variables of the master, in index order.
+	vector<int> artificial_columns; // indices of the artificial columns.
+	int artificial_row_count; // rows [0, artificial_row_count) have artificial columns.
+};
+
+// An open node of the branch and price tree. Its master is the master of its parent with the branching decisions
+// applied, and it is only built when the node is solved.
+struct Node
+{
+	shared_ptr<const MasterData> parent_master; // master of the parent (nullptr for the root, solved on the formulation).
+	BranchingChild branching; // decisions applied to the master of the parent.
+	double bound; // bound of the node (inherited from the parent until it is solved).
+	int id; // creation order (the root is 0).
+	int depth; // distance to the root.
+};
+
+// What happened when solving a node.
+// - Pruned: the node can not improve the incumbent (or it is infeasible).
+// - Integer: the solution of the master is integer.
+// - Branched: the solution of the master is fractional and the node was branched.
+// - Interrupted: the time limit was reached while solving the node.
+// - Unbounded: the master of the node is unbounded.
+enum class NodeOutcome { Pruned, Integer, Branched, Interrupted, Unbounded };
+
+// Result of solving a node, which is merged into the search afterwards.
+struct NodeResult
+{
+	NodeOutcome outcome;
+	double bound; // bound of the node after solving it.
+	CGExecutionLog cg_log; // log of the last column generation solved in the node.
+	Duration lp_time, pricing_time, branching_time; // time spent in the node.
+	vector<Node> children; // children of the node (their ids are assigned when the result is merged).
+};
+
+// Parameters of the search needed to solve a node. They are only read, so many nodes can be solved at the same time.
+struct NodeSearch
+{
+	const CGSolver& cg_solver;
+	const SeparationAlgorithm& separation_algorithm;
+	const BranchingRule& branching_rule;
+	const NodePricingFunction& node_pricing;
+	double artificial_cost;
+	Duration time_limit;
+	const Stopwatch& rolex;
+	bool minimizing;
+};
+
+// Open nodes of a thread, ordered by bound.
+struct NodeQueue
+{
+	mutex lock;
+	vector<Node> nodes; // heap by bound.
+};
+
+// Returns: if node n1 should be selected after node n2 (worse bound, ties broken by creation order).
+bool selected_after(const Node& n1, const Node& n2, bool minimizing)
+{
+	if (epsilon_different(n1.bound, n2.bound)) return minimizing ? n1.bound > n2.bound : n1.bound < n2.bound;
+	return n1.id > n2.id;
+}
+
+// Returns: if the bound can not improve the value of the incumbent.
+bool is_dominated(double bound, double incumbent_value, bool minimizing)
+{
+	if (fabs(incumbent_value) >= INFTY) return false;
+	return minimizing ? epsilon_bigger_equal(bound, incumbent_value) : epsilon_smaller_equal(bound, incumbent_value);
+}
+
+// Applies the branching decisions of the child to the master.
+void apply_branching(const BranchingChild& child, Formulation* master)
+{
+	if (child.rows.RowCount() > 0) master->AddConstraints(child.rows);
+	for (int i = 0; i < child.bounded_variables.size(); ++i)
+		master->SetVariableBound(master->VariableAtIndex(child.bounded_variables[i]), child.lower_bounds[i],
+			child.upper_bounds[i]);
+}
+
+// Adds artificial columns to the rows of the master with index at least first_row, one for each direction in which
+// the row can be violated, with cost artificial_cost for each unit of violation.
+// Returns: the artificial variables added.
+vector<Variable> add_artificial_columns(Formulation* master, int first_row, double artificial_cost)
+{
+	RowBuilder rows;
+	master->GetEmptyRows(&rows);
+	double cost = master->GetObjectiveSense() == Formulation::Minimization ? artificial_cost : -artificial_cost;
+	ColumnBuilder columns;
+	for (int i = first_row; i < rows.RowCount(); ++i)
+	{
+		if (rows.Senses()[i] != Constraint::LessEqual) columns.AddTerm(i, 1.0).EndColumn("artificial+_" + STR(i), cost);
+		if (rows.Senses()[i] != Constraint::GreaterEqual) columns.AddTerm(i, -1.0).EndColumn("artificial-_" + STR(i), cost);
+	}
+	if (columns.ColumnCount() == 0) return {};
+	return master->AddColumns(columns);
+}
+
+// Returns: the master of the node built in the solver environment of empty_master (nullptr for the root). Its rows
+// get artificial columns (the ones of the parent master are kept), so the branching decisions can not make it
+// infeasible while the columns that satisfy them are not generated yet. They are set in artificials.
+unique_ptr<Formulation> build_master(const Node& node, const Formulation& empty_master, double artificial_cost,
+	vector<Variable>* artificials)
+{
+	if (!node.parent_master) return nullptr;
+	unique_ptr<Formulation> master(empty_master.Copy());
+	master->AddConstraints(node.parent_master->rows);
+	master->AddColumns(node.parent_master->columns);
+	apply_branching(node.branching, master.get());
+	artificials->clear();
+	for (int j: node.parent_master->artificial_columns) artificials->push_back(master->VariableAtIndex(j));
+	for (auto& artificial: add_artificial_columns(master.get(), node.parent_master->artificial_row_count, artificial_cost))
+		artificials->push_back(artificial);
+	return master;
+}
+
+// Returns: if some of the artificial variables has a positive value in the solution.
+bool uses_artificials(const vector<Variable>& artificials, const Valuation& solution)
+{
+	for (auto& artificial: artificials) if (epsilon_bigger(solution[artificial], 0.0)) return true;
+	return false;
+}
+
+// Solves the node by column generation, separating cuts while they are found, and branches it if the solution is
+// fractional.
+// master: master of the node (it is modified by the column generation and the cuts).
+// artificials: artificial variables of the master (nullptr for the root, which has none). Cuts added to the master
+//	get artificial columns too.
+// lp_solver: lp solver used only by this thread.
+// incumbent_value: value of the best integer solution, used to prune (it can be improved by other threads).
+NodeResult solve_node(const NodeSearch& search, const Node& node, Formulation* master, vector<Variable>* artificials,
+	LPSolver* lp_solver, const atomic<double>& incumbent_value)
+{
+	NodeResult result;
+	result.outcome = NodeOutcome::Pruned;
+	result.bound = node.bound;
+	result.lp_time = result.pricing_time = result.branching_time = 0.0_sec;
+
+	CGSolver cg_solver = search.cg_solver;
+	cg_solver.screen_output = nullptr;
+	cg_solver.lp_solver = lp_solver;
+	if (search.node_pricing) cg_solver.pricing_oracles = search.node_pricing(master);
+	while (true)
+	{
+		if (search.rolex.Peek() >= search.time_limit) { result.outcome = NodeOutcome::Interrupted; return result; }
+		cg_solver.time_limit = search.time_limit - search.rolex.Peek();
+		cg_solver.cutoff = incumbent_value;
+		result.cg_log = cg_solver.Solve(master);
+		result.lp_time += result.cg_log.lp_time;
+		result.pricing_time += result.cg_log.pricing_time;
+		auto status = result.cg_log.status;
+		if (status == CGStatus::Unbounded) { result.outcome = NodeOutcome::Unbounded; return result; }
+		if (status == CGStatus::Infeasible || status == CGStatus::CutoffReached) return result;
+		if (status != CGStatus::Optimum && status != CGStatus::GapLimitReached)
+		{
+			result.outcome = NodeOutcome::Interrupted;
+			return result;
+		}
+
+		// The lp value is a bound when the column generation is optimal, otherwise the Lagrangian bound is.
+		double cg_bound = status == CGStatus::Optimum ? result.cg_log.incumbent_value : result.cg_log.lagrangian_bound;
+		result.bound = search.minimizing ? max(result.bound, cg_bound) : min(result.bound, cg_bound);
+		if (is_dominated(result.bound, incumbent_value, search.minimizing)) return result;
+		
+		// A solution that uses artificial columns is not a solution of the node. If the column generation is optimal
+		// the node is infeasible, otherwise it is solved to optimality to find out.
+		if (artificials && uses_artificials(*artificials, result.cg_log.incumbent))
+		{
+			if (status == CGStatus::Optimum) return result;
+			cg_solver.gap_limit = 0.0;
+			continue;
+		}
+		if (!search.separation_algorithm.IsEnabled()) break;
+		auto cuts = search.separation_algorithm.Separate(result.cg_log.incumbent, node.id, result.bound);
+		if (cuts.empty()) break;
+		int row_count = master->ConstraintCount();
+		master->AddConstraints(cuts);
+		if (artificials)
+			for (auto& artificial: add_artificial_columns(master, row_count, search.artificial_cost))
+				artificials->push_back(artificial);
+	}
+
+	// Integer solutions are reported, fractional ones are branched.
+	if (result.cg_log.incumbent.IsInteger())
+	{
+		result.outcome = NodeOutcome::Integer;
+		return result;
+	}
+	result.outcome = NodeOutcome::Branched;
+	Stopwatch branching_rolex(true);
+	auto children = search.branching_rule(master, result.cg_log.incumbent);
+	if (!children.empty())
+	{
+		// The children start from the columns and cuts of their parent, which are saved once for all of them.
+		auto master_data = make_shared<MasterData>();
+		master->GetEmptyRows(&master_data->rows);
+		master->GetColumns(master->Variables(), &master_data->columns);
+		if (artificials) for (auto& artificial: *artificials) master_data->artificial_columns.push_back(artificial.Index());
+		master_data->artificial_row_count = artificials ? master->ConstraintCount() : 0;
+		for (auto& child: children)
+			result.children.push_back({master_data, move(child), result.bound, -1, node.depth + 1});
+	}
+	result.branching_time = branching_rolex.Pause();
+	return result;
+}
+}
+
+BCPExecutionLog solve_bcp(Formulation* formulation,
+						  ostream* screen_output,
+						  Duration time_limit,
+						  const CGSolver& cg_solver,
+						  const SeparationStrategy& separation_strategy,
+						  const BranchingRule& branching_rule,
+						  const NodePricingFunction& node_pricing,
+						  double artificial_cost,
+						  int thread_count,
+						  bool deterministic,
+						  const unordered_set<BCOption>& options)
+{
+	// Cuts in a pool keep the variables of the master where they were found, which is destroyed with its node.
+	if (separation_strategy.cut_pool_age_limit > 0) fail("Branch and price does not support cut pools.");
+	if (!branching_rule) fail("Branch and price needs a branching rule.");
+
+	Stopwatch rolex(true);
+	bool minimizing = formulation->GetObjectiveSense() == Formulation::Minimization;
+	thread_count = max(thread_count, 1);
+
+	BCPExecutionLog execution_log;
+	execution_log.constraint_count = formulation->ConstraintCount();
+	execution_log.variable_count = formulation->VariableCount();
+	execution_log.best_int_value = minimizing ? INFTY : -INFTY;
+	execution_log.best_bound = minimizing ? -INFTY : INFTY;
+
+	// Write the progress to the screen, and to the log if requested.
+	mutex output_lock;
+	stringstream log_stream;
+	TableStream output(screen_output, 1.0), log_output(includes(options, BCOption::ScreenOutput) ? &log_stream : nullptr, 1.0);
+	for (TableStream* o: {&output, &log_output})
+	{
+		o->AddColumn("time", 10).AddColumn("#nodes", 8).AddColumn("#open", 8).AddColumn("bound", 12)
+			.AddColumn("int value", 12).AddColumn("#cols", 8);
+		o->WriteHeader();
+	}
+	auto write_progress = [&] (bool force, int open_count, double bound, int column_count) {
+		lock_guard<mutex> guard(output_lock);
+		vector<string> row = {STR(rolex.Peek()), STR(execution_log.nodes_closed), STR(open_count), STR(bound),
+			STR(execution_log.best_int_value), STR(column_count)};
+		if (output.RegisterAttempt() || force) output.WriteRow(row);
+		if (log_output.RegisterAttempt() || force) log_output.WriteRow(row);
+	};
+
+	SeparationAlgorithm separation_algorithm(separation_strategy);
+	NodeSearch search{cg_solver, separation_algorithm, branching_rule, node_pricing, artificial_cost, time_limit, rolex,
+		minimizing};
+	vector<LPSolver> lp_solvers(thread_count, *cg_solver.lp_solver); // lp solvers are not thread safe.
+	
+	// Each thread builds the masters of the nodes it solves in its own solver environment, which is created once (the
+	// masters are copies of an empty master in that environment).
+	vector<unique_ptr<Formulation>> empty_masters;
+	for (int w = 0; w < thread_count; ++w)
+	{
+		empty_masters.emplace_back(CGSolver::NewFormulation());
+		if (minimizing) empty_masters[w]->Minimize(Expression());
+		else empty_masters[w]->Maximize(Expression());
+		for (auto lazy_constraint: formulation->LazyConstraints()) empty_masters[w]->AddLazyConstraint(lazy_constraint);
+	}
+
+	// Best integer solution found. Its value is atomic so threads can prune with it while it is being updated.
+	atomic<double> incumbent_value(execution_log.best_int_value);
+	ColumnBuilder incumbent_columns; // columns of the master variables with positive value in the best solution.
+	vector<double> incumbent_values; // incumbent_values[j] is the value of column j of incumbent_columns.
+
+	// Adds the result of solving the node to the log, and updates the incumbent with it.
+	// Precondition: results are merged by one thread at a time.
+	bool unbounded = false;
+	auto merge = [&] (const Node& node, Formulation* master, const NodeResult& result) {
+		execution_log.lp_time += result.lp_time;
+		execution_log.pricing_time += result.pricing_time;
+		execution_log.branching_time += result.branching_time;
+		if (node.id == 0)
+		{
+			execution_log.root_log = result.cg_log.ToJSON();
+			execution_log.root_lp_value = result.cg_log.incumbent_value;
+			execution_log.root_constraint_count = formulation->ConstraintCount();
+			execution_log.root_variable_count = formulation->VariableCount();
+		}
+		if (result.outcome == NodeOutcome::Interrupted) return;
+		++execution_log.nodes_closed;
+		if (result.outcome == NodeOutcome::Unbounded) unbounded = true;
+		if (result.outcome != NodeOutcome::Integer) return;
+		if (is_dominated(result.cg_log.incumbent_value, execution_log.best_int_value, minimizing)) return;
+		execution_log.best_int_value = incumbent_value = result.cg_log.incumbent_value;
+		vector<Variable> variables;
+		for (auto& variable_value: result.cg_log.incumbent) variables.push_back(variable_value.first);
+		sort(variables.begin(), variables.end(), [] (const Variable& v1, const Variable& v2) { return v1.Index() < v2.Index(); });
+		incumbent_columns.Clear();
+		master->GetColumns(variables, &incumbent_columns);
+		incumbent_values.clear();
+		for (auto& variable: variables) incumbent_values.push_back(result.cg_log.incumbent[variable]);
+		if (node.id == 0) execution_log.root_int_value = result.cg_log.incumbent_value;
+		if (node.id == 0 && includes(options, BCOption::RootInformation)) execution_log.root_int_solution = result.cg_log.incumbent;
+		write_progress(true, 0, result.bound, master->VariableCount());
+	};
+
+	// Open nodes, in a heap by best bound. The root is solved on the formulation.
+	auto node_order = [&] (const Node& n1, const Node& n2) { return selected_after(n1, n2, minimizing); };
+	vector<Node> open_nodes;
+	open_nodes.push_back({nullptr, BranchingChild(), execution_log.best_bound, 0, 0});
+	atomic<int> node_count(1);
+
+	// Solves the best open nodes (up to one per thread) at the same time, and merges their results in node order.
+	// Returns: if the search must stop.
+	unique_ptr<ThreadPool> thread_pool(thread_count > 1 ? new ThreadPool(thread_count) : nullptr);
+	auto solve_round = [&] () {
+		vector<Node> round;
+		while (!open_nodes.empty() && round.size() < thread_count)
+		{
+			pop_heap(open_nodes.begin(), open_nodes.end(), node_order);
+			Node node = move(open_nodes.back());
+			open_nodes.pop_back();
+			if (is_dominated(node.bound, incumbent_value, minimizing)) ++execution_log.nodes_closed;
+			else round.push_back(move(node));
+		}
+		vector<NodeResult> results(round.size());
+		vector<unique_ptr<Formulation>> masters(round.size());
+		vector<vector<Variable>> artificials(round.size());
+		auto master_of = [&] (int i) { return masters[i] ? masters[i].get() : formulation; };
+		vector<function<void()>> tasks;
+		for (int i = 0; i < round.size(); ++i)
+		{
+			tasks.push_back([&, i] {
+				masters[i] = build_master(round[i], *empty_masters[i], artificial_cost, &artificials[i]);
+				results[i] = solve_node(search, round[i], master_of(i), masters[i] ? &artificials[i] : nullptr,
+					&lp_solvers[i], incumbent_value);
+			});
+		}
+		if (thread_pool) thread_pool->Run(tasks);
+		else for (auto& task: tasks) task();
+
+		bool stop = false;
+		for (int i = 0; i < round.size(); ++i)
+		{
+			merge(round[i], master_of(i), results[i]);
+			stop = stop || results[i].outcome == NodeOutcome::Interrupted || results[i].outcome == NodeOutcome::Unbounded;
+			if (results[i].outcome == NodeOutcome::Interrupted) round[i].bound = results[i].bound;
+			vector<Node> nodes;
+			if (results[i].outcome == NodeOutcome::Interrupted) nodes.push_back(move(round[i]));
+			for (auto& child: results[i].children) { child.id = node_count++; nodes.push_back(move(child)); }
+			for (auto& node: nodes)
+			{
+				open_nodes.push_back(move(node));
+				push_heap(open_nodes.begin(), open_nodes.end(), node_order);
+			}
+			write_progress(false, open_nodes.size(), results[i].bound, master_of(i)->VariableCount());
+		}
+		return stop;
+	};
+
+	if (deterministic || thread_count == 1)
+	{
+		while (!open_nodes.empty())
+		{
+			if (rolex.Peek() >= time_limit || solve_round()) break;
+		}
+	}
+	else if (!solve_round())
+	{
+		// Spread the children of the root among the threads. Each thread solves the best node of its own queue, and
+		// steals the best node of the queue of another thread when its queue is empty.
+		vector<unique_ptr<NodeQueue>> queues;
+		for (int w = 0; w < thread_count; ++w) queues.push_back(unique_ptr<NodeQueue>(new NodeQueue()));
+		for (int k = 0; k < open_nodes.size(); ++k) queues[k % thread_count]->nodes.push_back(move(open_nodes[k]));
+		for (auto& queue: queues) make_heap(queue->nodes.begin(), queue->nodes.end(), node_order);
+		atomic<int> queued_count(open_nodes.size()); // number of nodes in the queues.
+		atomic<int> pending_count(open_nodes.size()); // number of nodes in the queues or being solved.
+		atomic<bool> stop(false);
+		mutex idle_lock, merge_lock;
+		condition_variable idle;
+		open_nodes.clear();
+
+		auto push_node = [&] (int w, Node node) {
+			lock_guard<mutex> guard(queues[w]->lock);
+			queues[w]->nodes.push_back(move(node));
+			push_heap(queues[w]->nodes.begin(), queues[w]->nodes.end(), node_order);
+			++queued_count;
+			++pending_count;
+		};
+		auto take_node = [&] (int w, Node* node) {
+			for (int k = 0; k < thread_count; ++k)
+			{
+				auto& queue = *queues[(w + k) % thread_count];
+				lock_guard<mutex> guard(queue.lock);
+				if (queue.nodes.empty()) continue;
+				pop_heap(queue.nodes.begin(), queue.nodes.end(), node_order);
+				*node = move(queue.nodes.back());
+				queue.nodes.pop_back();
+				--queued_count;
+				return true;
+			}
+			return false;
+		};
+		auto notify_all = [&] {
+			lock_guard<mutex> guard(idle_lock);
+			idle.notify_all();
+		};
+		auto work = [&] (int w) {
+			while (true)
+			{
+				Node node;
+				if (!take_node(w, &node))
+				{
+					unique_lock<mutex> guard(idle_lock);
+					idle.wait(guard, [&] { return queued_count > 0 || pending_count == 0 || stop; });
+					if (pending_count == 0 || stop) return;
+					continue;
+				}
+				if (stop || rolex.Peek() >= time_limit)
+				{
+					push_node(w, move(node));
+					--pending_count;
+					stop = true;
+					notify_all();
+					return;
+				}
+				if (is_dominated(node.bound, incumbent_value, minimizing))
+				{
+					lock_guard<mutex> guard(merge_lock);
+					++execution_log.nodes_closed;
+				}
+				else
+				{
+					vector<Variable> artificials;
+					auto master = build_master(node, *empty_masters[w], artificial_cost, &artificials);
+					auto result = solve_node(search, node, master.get(), &artificials, &lp_solvers[w], incumbent_value);
+					lock_guard<mutex> guard(merge_lock);
+					merge(node, master.get(), result);
+					if (result.outcome == NodeOutcome::Interrupted || result.outcome == NodeOutcome::Unbounded) stop = true;
+					if (result.outcome == NodeOutcome::Interrupted) node.bound = result.bound;
+					if (result.outcome == NodeOutcome::Interrupted) push_node(w, move(node));
+					for (auto& child: result.children) { child.id = node_count++; push_node(w, move(child)); }
+					write_progress(false, queued_count, result.bound, master->VariableCount());
+				}
+				--pending_count;
+				notify_all();
+			}
+		};
+		vector<function<void()>> workers;
+		for (int w = 0; w < thread_count; ++w) workers.push_back([&, w] { work(w); });
+		thread_pool->Run(workers);
+		for (auto& queue: queues) for (auto& node: queue->nodes) open_nodes.push_back(move(node));
+	}
+
+	// The best bound is the one of the best open node, or the incumbent if the tree was closed.
+	execution_log.nodes_open = open_nodes.size();
+	if (unbounded)
+	{
+		execution_log.status = BCStatus::Unbounded;
+	}
+	else if (open_nodes.empty())
+	{
+		execution_log.best_bound = execution_log.best_int_value;
+		execution_log.status = fabs(execution_log.best_int_value) < INFTY ? BCStatus::Optimum : BCStatus::Infeasible;
+	}
+	else
+	{
+		execution_log.best_bound = open_nodes.front().bound;
+		for (auto& node: open_nodes)
+			execution_log.best_bound = minimizing ? min(execution_log.best_bound, node.bound) : max(execution_log.best_bound, node.bound);
+		execution_log.status = BCStatus::TimeLimitReached;
+	}
+	write_progress(true, open_nodes.size(), execution_log.best_bound, formulation->VariableCount());
+	if (screen_output) *screen_output << endl;
+
+	// Bring the columns of the best solution to the formulation (restricted to its rows), and express the solution
+	// with its variables.
+	if (incumbent_columns.ColumnCount() > 0)
+	{
+		unordered_map<string, Variable> variable_by_name;
+		for (auto& variable: formulation->Variables()) variable_by_name.insert({variable.Name(), variable});
+		ColumnBuilder missing_columns;
+		vector<int> missing_positions;
+		auto& begin = incumbent_columns.ColumnBegin();
+		for (int j = 0; j < incumbent_columns.ColumnCount(); ++j)
+		{
+			if (includes_key(variable_by_name, incumbent_columns.Names()[j])) continue;
+			int end = j + 1 < incumbent_columns.ColumnCount() ? begin[j + 1] : incumbent_columns.NonZeroCount();
+			for (int k = begin[j]; k < end; ++k)
+				if (incumbent_columns.RowIndices()[k] < formulation->ConstraintCount())
+					missing_columns.AddTerm(incumbent_columns.RowIndices()[k], incumbent_columns.Values()[k]);
+			missing_columns.EndColumn(incumbent_columns.Names()[j], incumbent_columns.ObjectiveCoefficients()[j],
+				incumbent_columns.Domains()[j], incumbent_columns.LowerBounds()[j], incumbent_columns.UpperBounds()[j]);
+			missing_positions.push_back(j);
+		}
+		auto added = formulation->AddColumns(missing_columns);
+		for (int i = 0; i < added.size(); ++i) variable_by_name.insert({incumbent_columns.Names()[missing_positions[i]], added[i]});
+		if (includes(options, BCOption::BestIntSolution))
+			for (int j = 0; j < incumbent_columns.ColumnCount(); ++j)
+				execution_log.best_int_solution.SetValue(variable_by_name.at(incumbent_columns.Names()[j]), incumbent_values[j]);
+	}
+
+	// Statistics of the cuts.
+	if (includes(options, BCOption::CutInformation))
+	{
+		execution_log.cut_count = separation_algorithm.CutsAdded();
+		execution_log.cut_time = separation_algorithm.SeparationTime();
+		execution_log.cut_families = separation_strategy.Families();
+		for (auto& family: separation_strategy.Families())
+		{
+			execution_log.cut_family_cut_count[family] = separation_algorithm.CutsAdded(family);
+			execution_log.cut_family_iteration_count[family] = separation_algorithm.IterationCount(family);
+			execution_log.cut_family_cut_time[family] = separation_algorithm.SeparationTime(family);
+		}
+	}
+	execution_log.final_constraint_count = formulation->ConstraintCount();
+	execution_log.final_variable_count = formulation->VariableCount();
+	execution_log.screen_output = log_stream.str();
+	execution_log.time = rolex.Peek();
+	return execution_log;
+}
+} // namespace goc
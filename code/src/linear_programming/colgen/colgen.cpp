@@ -6,6 +6,13 @@
 
 #include "goc/linear_programming/colgen/colgen.h"
 
+#include <cmath>
+#include <map>
+#include <memory>
+
+#include "goc/collection/collection_utils.h"
+#include "goc/concurrency/thread_pool.h"
+#include "goc/linear_programming/colgen/column_pool.h"
 #include "goc/lib/json.hpp"
 #include "goc/time/duration.h"
 #include "goc/time/stopwatch.h"
@@ -29,16 +36,142 @@ CGStatus parse_lp_status(LPStatus status)
 {
 	return mapper[status];
 }
+
+// Returns: the reduced cost if it improves the master (negative if minimizing, positive if maximizing), 0 otherwise.
+double improving_part(double reduced_cost, bool minimizing)
+{
+	return minimizing ? min(reduced_cost, 0.0) : max(reduced_cost, 0.0);
+}
+
+// Returns: the Lagrangian bound duals * rhs + reduced_cost_term, where reduced_cost_term is the convexity bound times
+// the improving part of the best reduced cost (or the sum of these terms over the subproblems).
+double lagrangian_bound(const Formulation* formulation, const vector<double>& duals, double reduced_cost_term)
+{
+	double bound = reduced_cost_term;
+	for (int i = 0; i < duals.size(); ++i) bound += duals[i] * formulation->GetConstraintRightHandSide(i);
+	return bound;
+}
+
+// Calls the pricing oracles by level until one level changes the master. Oracles of the same level are called
+// concurrently if there is a thread pool, and their columns are merged in the order of the oracles.
+// reduced_cost_term: if all the oracles of the last level called have a convexity bound, it is set to the sum of
+//	their convexity bound times the improving part of their best reduced cost. Otherwise it is set to NaN.
+// interrupted: it is set to whether a level was not called because the time limit was reached (so the pricing might
+//	have missed improving columns).
+// Returns: the merged result of the last level called (exact only if all its oracles were exact).
+PricingResult solve_pricing(const map<int, vector<const PricingOracle*>>& oracle_levels, ThreadPool* thread_pool,
+	const vector<double>& duals, double incumbent_value, Duration time_limit, const Stopwatch& rolex, bool minimizing,
+	bool keep_iterations, CGExecutionLog* execution_log, double* reduced_cost_term, bool* interrupted)
+{
+	PricingResult merged;
+	*reduced_cost_term = NAN;
+	*interrupted = false;
+	for (auto& level: oracle_levels)
+	{
+		auto& oracles = level.second;
+		if (rolex.Peek() >= time_limit) { *interrupted = true; break; }
+		Duration oracle_time_limit = time_limit - rolex.Peek();
+		
+		// Oracles called one after the other receive the execution log itself. Concurrent oracles receive a copy of it
+		// (without its iterations), and the iterations they add are merged afterwards.
+		bool concurrent = thread_pool && oracles.size() > 1;
+		vector<CGExecutionLog> oracle_logs;
+		if (concurrent)
+		{
+			vector<json> iterations;
+			iterations.swap(execution_log->iterations);
+			oracle_logs.assign(oracles.size(), *execution_log);
+			iterations.swap(execution_log->iterations);
+		}
+		
+		// Call the oracles of the level.
+		vector<PricingResult> results(oracles.size());
+		vector<Duration> oracle_times(oracles.size());
+		vector<function<void()>> tasks;
+		for (int k = 0; k < oracles.size(); ++k)
+		{
+			tasks.push_back([&, k] () {
+				Stopwatch oracle_rolex(true);
+				CGExecutionLog* oracle_log = concurrent ? &oracle_logs[k] : execution_log;
+				results[k] = oracles[k]->function(duals, incumbent_value, oracle_time_limit, oracle_log);
+				oracle_times[k] = oracle_rolex.Pause();
+			});
+		}
+		if (concurrent) thread_pool->Run(tasks);
+		else for (auto& task: tasks) task();
+		
+		// Merge the results and logs in the order of the oracles.
+		merged = PricingResult();
+		merged.exact = true;
+		merged.best_reduced_cost = results.empty() ? 0.0 : results[0].best_reduced_cost;
+		*reduced_cost_term = 0.0;
+		for (int k = 0; k < oracles.size(); ++k)
+		{
+			merged.columns.AddColumns(results[k].columns);
+			merged.formulation_changed = merged.formulation_changed || results[k].formulation_changed;
+			merged.exact = merged.exact && results[k].exact;
+			merged.best_reduced_cost = minimizing ? min(merged.best_reduced_cost, results[k].best_reduced_cost)
+												  : max(merged.best_reduced_cost, results[k].best_reduced_cost);
+			if (oracles[k]->convexity_bound > 0.0)
+				*reduced_cost_term += oracles[k]->convexity_bound * improving_part(results[k].best_reduced_cost, minimizing);
+			else
+				*reduced_cost_term = NAN;
+			execution_log->oracle_time[oracles[k]->name] += oracle_times[k];
+			execution_log->oracle_column_count[oracles[k]->name] += results[k].columns.ColumnCount();
+			if (concurrent) for (auto& iteration: oracle_logs[k].iterations) execution_log->iterations.push_back(iteration);
+			if (keep_iterations)
+			{
+				execution_log->iterations.push_back({{"iteration", execution_log->iteration_count},
+					{"oracle", oracles[k]->name}, {"time", oracle_times[k]},
+					{"columns", results[k].columns.ColumnCount()}, {"best_reduced_cost", results[k].best_reduced_cost}});
+			}
+		}
+		if (merged.MasterChanged()) break;
+	}
+	return merged;
+}
+
+// Returns: if some of the columns improves the master at the duals (its reduced cost is negative if minimizing, positive
+// if maximizing). Constraints with index >= duals.size() have dual 0.
+bool has_improving_column(const ColumnBuilder& columns, const vector<double>& duals, bool minimizing)
+{
+	for (int j = 0; j < columns.ColumnCount(); ++j)
+	{
+		int end = j + 1 < columns.ColumnCount() ? columns.ColumnBegin()[j + 1] : columns.NonZeroCount();
+		double reduced_cost = columns.ObjectiveCoefficients()[j];
+		for (int k = columns.ColumnBegin()[j]; k < end; ++k)
+			if (columns.RowIndices()[k] < duals.size()) reduced_cost -= columns.Values()[k] * duals[columns.RowIndices()[k]];
+		if (minimizing ? epsilon_smaller(reduced_cost, 0.0) : epsilon_bigger(reduced_cost, 0.0)) return true;
+	}
+	return false;
+}
+
+// Returns: the duals alpha * center + (1-alpha) * duals.
+vector<double> smooth_duals(const vector<double>& center, const vector<double>& duals, double alpha)
+{
+	vector<double> smoothed(duals.size());
+	for (int i = 0; i < duals.size(); ++i) smoothed[i] = alpha * center[i] + (1.0 - alpha) * duals[i];
+	return smoothed;
+}
 }
 
 CGExecutionLog solve_colgen(Formulation* formulation,
 				   ostream* screen_output,
 				   Duration time_limit,
-				   const PricingFunction& pricing_function,
+				   const vector<PricingOracle>& pricing_oracles,
+				   int pricing_thread_count,
 				   LPSolver* lp_solver,
+				   double smoothing_alpha,
+				   bool automatic_smoothing,
+				   double convexity_bound,
+				   double gap_limit,
+				   double cutoff,
+				   int column_age_limit,
+				   int pool_extract_limit,
 				   const unordered_set<CGOption>& option)
 {
 	Stopwatch rolex(true);
+	bool minimizing = formulation->GetObjectiveSense() == Formulation::Minimization;
 	
 	// Keep track of the execution.
 	CGExecutionLog execution_log;
@@ -46,11 +179,12 @@ CGExecutionLog solve_colgen(Formulation* formulation,
 	execution_log.pricing_time = 0.0_sec;
 	execution_log.iterations = vector<json>{};
 	execution_log.iteration_count = 0;
+	execution_log.lagrangian_bound = minimizing ? -INFTY : INFTY;
 	
 	execution_log.status = CGStatus::Optimum;
 	
 	TableStream output(screen_output, 1.0);
-	output.AddColumn("time", 10).AddColumn("#", 5).AddColumn("value", 10).AddColumn("#cols", 7);
+	output.AddColumn("time", 10).AddColumn("#", 5).AddColumn("value", 10).AddColumn("bound", 10).AddColumn("#cols", 7);
 	
 	// While the pricing problem finds new columns, keep iterating.
 	int variable_count = -1, initial_variable_count = formulation->VariableCount();
@@ -58,6 +192,15 @@ CGExecutionLog solve_colgen(Formulation* formulation,
 	output.WriteHeader();
 	double objective_value = 0.0;
 	bool keep_iterating = true;
+	vector<double> center; // stability center of the smoothing (the last priced point that improved the bound).
+	double alpha = smoothing_alpha;
+	ColumnPool column_pool; // columns removed from the lp.
+	
+	// Group the oracles by level, and create the threads to call the oracles of a level concurrently.
+	map<int, vector<const PricingOracle*>> oracle_levels;
+	for (auto& oracle: pricing_oracles) oracle_levels[oracle.level].push_back(&oracle);
+	unique_ptr<ThreadPool> thread_pool(pricing_thread_count > 1 ? new ThreadPool(pricing_thread_count) : nullptr);
+	vector<int> column_age; // column_age[j] is the number of iterations column initial_variable_count+j did not improve.
 	while (keep_iterating)
 	{
 		keep_iterating = false;
@@ -65,36 +208,155 @@ CGExecutionLog solve_colgen(Formulation* formulation,
 		if (rolex.Peek() >= time_limit) {execution_log.status = CGStatus::TimeLimitReached; break; }
 		
 		// Solve LP relaxation to get dual variables.
-		auto lp_log = lp_solver->Solve(formulation, {LPOption::Duals, LPOption::Incumbent});
+		unordered_set<LPOption> lp_options = {LPOption::Duals, LPOption::Incumbent};
+		if (column_age_limit > 0) lp_options.insert(LPOption::ReducedCosts);
+		auto lp_log = lp_solver->Solve(formulation, lp_options);
 		execution_log.lp_time += lp_log.time;
 		
 		if (lp_log.status != LPStatus::Optimum) { execution_log.status = parse_lp_status(lp_log.status); break; }
 		objective_value = lp_log.incumbent_value;
-		if (output.RegisterAttempt()) output.WriteRow({STR(rolex.Peek()), STR(execution_log.iteration_count++), STR(objective_value), STR(formulation->VariableCount())});
+		++execution_log.iteration_count;
+		if (output.RegisterAttempt()) output.WriteRow({STR(rolex.Peek()), STR(execution_log.iteration_count), STR(objective_value), STR(execution_log.lagrangian_bound), STR(formulation->VariableCount())});
+		
+		// Move the columns that did not improve the master for too long to the pool. They are non basic, so removing
+		// them keeps the lp solution and duals.
+		if (column_age_limit > 0)
+		{
+			vector<Variable> aged_columns;
+			vector<int> remaining_age;
+			column_age.resize(formulation->VariableCount() - initial_variable_count, 0);
+			for (int j = 0; j < column_age.size(); ++j)
+			{
+				double reduced_cost = lp_log.reduced_costs[initial_variable_count + j];
+				bool improves = minimizing ? epsilon_smaller_equal(reduced_cost, 0.0) : epsilon_bigger_equal(reduced_cost, 0.0);
+				column_age[j] = improves ? 0 : column_age[j] + 1;
+				if (column_age[j] >= column_age_limit) aged_columns.push_back(formulation->VariableAtIndex(initial_variable_count + j));
+				else remaining_age.push_back(column_age[j]);
+			}
+			if (!aged_columns.empty())
+			{
+				ColumnBuilder removed;
+				formulation->GetColumns(aged_columns, &removed);
+				column_pool.Add(removed);
+				formulation->RemoveVariables(aged_columns);
+				execution_log.columns_removed += aged_columns.size();
+				column_age = remaining_age;
+			}
+		}
 		
 		// Update variable count before solving the pricing problem.
 		variable_count = formulation->VariableCount();
 		row_count = formulation->ConstraintCount();
 		
-		// Solve the pricing problem (i.e. add new variables to the formulation).
-		auto pricing_tl = time_limit - rolex.Peek();
+		// Solves the pricing problem for the duals and updates the Lagrangian bound if the pricing was exact.
+		// bound_computed and bound_improved are set to whether a Lagrangian bound was computed and if it improved.
+		// If the time limit did not let the pricing call all its levels, the status is set to TimeLimitReached (the lp
+		// value is not a bound, since there might be improving columns).
+		// Returns: the result of the pricing.
+		bool bound_computed = false, bound_improved = false;
+		auto price = [&] (const vector<double>& duals) {
+			double reduced_cost_term;
+			bool interrupted;
+			auto result = solve_pricing(oracle_levels, thread_pool.get(), duals, lp_log.incumbent_value, time_limit,
+				rolex, minimizing, includes(option, CGOption::IterationsInformation), &execution_log, &reduced_cost_term,
+				&interrupted);
+			if (interrupted) execution_log.status = CGStatus::TimeLimitReached;
+			if (std::isnan(reduced_cost_term) && convexity_bound > 0.0)
+				reduced_cost_term = convexity_bound * improving_part(result.best_reduced_cost, minimizing);
+			bound_computed = result.exact && !std::isnan(reduced_cost_term);
+			bound_improved = false;
+			if (bound_computed)
+			{
+				double bound = lagrangian_bound(formulation, duals, reduced_cost_term);
+				execution_log.bound_trajectory.push_back({execution_log.iteration_count, bound});
+				if (minimizing ? bound > execution_log.lagrangian_bound : bound < execution_log.lagrangian_bound)
+				{
+					execution_log.lagrangian_bound = bound;
+					bound_improved = true;
+				}
+			}
+			return result;
+		};
+		
+		// Adds the columns of the pricing result to the formulation.
+		// Returns: if the master changed.
+		auto add_columns = [&] (const PricingResult& result) {
+			if (result.columns.ColumnCount() > 0) formulation->AddColumns(result.columns);
+			return result.MasterChanged();
+		};
+		
+		// Solve the pricing problem (i.e. add new variables to the formulation). Pooled columns that improve the
+		// master at the LP duals are added back first, the pricing function is only called if there are none.
 		if (rolex.Peek() >= time_limit) { execution_log.status = CGStatus::TimeLimitReached; break; }
 		Stopwatch pricing_rolex(true);
-		keep_iterating = pricing_function(lp_log.duals, lp_log.incumbent_value, pricing_tl, &execution_log);
+		ColumnBuilder pooled_columns;
+		if (column_pool.Extract(lp_log.duals, minimizing, &pooled_columns, pool_extract_limit) > 0)
+		{
+			formulation->AddColumns(pooled_columns);
+			execution_log.columns_from_pool += pooled_columns.ColumnCount();
+			keep_iterating = true;
+		}
+		else if (alpha > 0.0 && center.size() == lp_log.duals.size())
+		{
+			// Price the smoothed duals. The center only moves to points that improve the Lagrangian bound, or to every
+			// point priced successfully if there is no bound to compare.
+			auto smoothed_duals = smooth_duals(center, lp_log.duals, alpha);
+			++execution_log.smoothed_pricing_count;
+			auto result = price(smoothed_duals);
+			if (result.formulation_changed || has_improving_column(result.columns, lp_log.duals, minimizing))
+			{
+				keep_iterating = add_columns(result);
+				if (bound_improved || !bound_computed) center = smoothed_duals;
+				if (automatic_smoothing) alpha = min(0.99, alpha + 0.1 * (1.0 - alpha));
+			}
+			else
+			{
+				// Mispricing: no column found at the smoothed point improves the master at the LP duals, so they
+				// would not change the LP solution. They are discarded and the LP duals are priced instead.
+				++execution_log.mispricing_count;
+				if (bound_improved) center = smoothed_duals;
+				if (automatic_smoothing) alpha /= 2.0;
+				if (rolex.Peek() < time_limit)
+				{
+					keep_iterating = add_columns(price(lp_log.duals));
+					if (bound_improved || !bound_computed) center = lp_log.duals;
+				}
+				else execution_log.status = CGStatus::TimeLimitReached;
+			}
+		}
+		else
+		{
+			keep_iterating = add_columns(price(lp_log.duals));
+			if (alpha > 0.0) center = lp_log.duals;
+		}
 		execution_log.pricing_time += pricing_rolex.Pause();
+		execution_log.columns_added += formulation->VariableCount() - variable_count;
+		
+		// Stop early if the Lagrangian bound is close enough to the lp value, or if it reached the cutoff.
+		if (!keep_iterating || fabs(execution_log.lagrangian_bound) >= INFTY) continue;
+		if (gap_limit > 0.0 && fabs(objective_value - execution_log.lagrangian_bound) <= gap_limit * fabs(objective_value))
+		{
+			execution_log.status = CGStatus::GapLimitReached;
+			keep_iterating = false;
+		}
+		else if (fabs(cutoff) < INFTY && (minimizing ? epsilon_bigger_equal(execution_log.lagrangian_bound, cutoff)
+													 : epsilon_smaller_equal(execution_log.lagrangian_bound, cutoff)))
+		{
+			execution_log.status = CGStatus::CutoffReached;
+			keep_iterating = false;
+		}
 	}
-	output.WriteRow({STR(rolex.Peek()), STR(execution_log.iteration_count), STR(objective_value), STR(formulation->VariableCount())});
+	output.WriteRow({STR(rolex.Peek()), STR(execution_log.iteration_count), STR(objective_value), STR(execution_log.lagrangian_bound), STR(formulation->VariableCount())});
 	if (screen_output) *screen_output << endl;
 	
-	// If the column generation was solved to optimality, get the actual solution.
-	if (execution_log.status == CGStatus::Optimum)
+	// If the column generation was solved to optimality (or within the gap), get the actual solution.
+	if (execution_log.status == CGStatus::Optimum || execution_log.status == CGStatus::GapLimitReached)
 	{
 		lp_solver->time_limit = Duration::Max();
 		auto lp_log = lp_solver->Solve(formulation, {LPOption::Incumbent});
 		execution_log.incumbent_value = lp_log.incumbent_value;
 		execution_log.incumbent = lp_log.incumbent;
 	}
-	execution_log.columns_added = formulation->VariableCount() - initial_variable_count;
 	execution_log.time = rolex.Peek();
 	
 	return execution_log;
@@ -0,0 +1,114 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/colgen/column_pool.h"
+
+#include <algorithm>
+
+#include "goc/math/number_utils.h"
+
+using namespace std;
+
+namespace goc
+{
+namespace
+{
+// Appends the column j of 'from' at the end of 'to'.
+void copy_column(const ColumnBuilder& from, int j, ColumnBuilder* to)
+{
+	int end = j + 1 < from.ColumnCount() ? from.ColumnBegin()[j + 1] : from.NonZeroCount();
+	for (int k = from.ColumnBegin()[j]; k < end; ++k) to->AddTerm(from.RowIndices()[k], from.Values()[k]);
+	to->EndColumn(from.Names()[j], from.ObjectiveCoefficients()[j], from.Domains()[j], from.LowerBounds()[j],
+		from.UpperBounds()[j]);
+}
+}
+
+ColumnPool::ColumnPool() : row_count_(0)
+{ }
+
+void ColumnPool::Add(const ColumnBuilder& columns)
+{
+	for (int j = 0; j < columns.ColumnCount(); ++j) copy_column(columns, j, &columns_);
+	for (int i: columns.RowIndices()) row_count_ = max(row_count_, i + 1);
+}
+
+void ColumnPool::ReducedCosts(const vector<double>& duals, vector<double>* reduced_costs) const
+{
+	// Pad the duals so the kernel does not have to check the constraint indices.
+	const double* pi = duals.data();
+	vector<double> padded_duals;
+	if (row_count_ > duals.size())
+	{
+		padded_duals = duals;
+		padded_duals.resize(row_count_, 0.0);
+		pi = padded_duals.data();
+	}
+	
+	// Compute c_j - duals * A_j column by column over the CSC arrays.
+	int column_count = columns_.ColumnCount();
+	const int* column_begin = columns_.ColumnBegin().data();
+	const int* row_indices = columns_.RowIndices().data();
+	const double* values = columns_.Values().data();
+	const double* costs = columns_.ObjectiveCoefficients().data();
+	reduced_costs->resize(column_count);
+	double* rc = reduced_costs->data();
+	for (int j = 0; j < column_count; ++j)
+	{
+		int end = j + 1 < column_count ? column_begin[j + 1] : columns_.NonZeroCount();
+		double dot = 0.0;
+		for (int k = column_begin[j]; k < end; ++k) dot += values[k] * pi[row_indices[k]];
+		rc[j] = costs[j] - dot;
+	}
+}
+
+vector<int> ColumnPool::MostImproving(const vector<double>& duals, bool minimizing, int count_limit) const
+{
+	vector<double> reduced_costs;
+	ReducedCosts(duals, &reduced_costs);
+	vector<int> improving;
+	for (int j = 0; j < reduced_costs.size(); ++j)
+		if (minimizing ? epsilon_smaller(reduced_costs[j], 0.0) : epsilon_bigger(reduced_costs[j], 0.0))
+			improving.push_back(j);
+	
+	// Keep only the best count_limit columns.
+	auto better = [&] (int i, int j) { return minimizing ? reduced_costs[i] < reduced_costs[j]
+														 : reduced_costs[i] > reduced_costs[j]; };
+	if (improving.size() > count_limit)
+	{
+		nth_element(improving.begin(), improving.begin() + count_limit, improving.end(), better);
+		improving.resize(count_limit);
+	}
+	sort(improving.begin(), improving.end(), better);
+	return improving;
+}
+
+int ColumnPool::Extract(const vector<double>& duals, bool minimizing, ColumnBuilder* columns, int count_limit)
+{
+	vector<int> selected = MostImproving(duals, minimizing, count_limit);
+	if (selected.empty()) return 0;
+	
+	// Move the selected columns and compact the pool with the rest.
+	vector<bool> is_selected(columns_.ColumnCount(), false);
+	for (int j: selected)
+	{
+		copy_column(columns_, j, columns);
+		is_selected[j] = true;
+	}
+	columns_.RemoveColumns(is_selected);
+	return selected.size();
+}
+
+int ColumnPool::Size() const
+{
+	return columns_.ColumnCount();
+}
+
+void ColumnPool::Clear()
+{
+	columns_.Clear();
+	row_count_ = 0;
+}
+} // namespace goc
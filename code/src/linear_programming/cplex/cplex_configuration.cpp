@@ -0,0 +1,118 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/cplex/cplex_configuration.h"
+
+#include <algorithm>
+
+#include "goc/exception/exception_utils.h"
+#include "goc/string/string_utils.h"
+
+using namespace std;
+using namespace nlohmann;
+
+namespace goc
+{
+namespace
+{
+// Sends the parameter value to the CPLEX environment.
+void apply_parameter(CPXENVptr env, const CplexParameter& parameter)
+{
+	if (parameter.type == CPX_PARAMTYPE_INT)
+		cplex::setintparam(env, parameter.number, (CPXINT)parameter.integer_value);
+	else if (parameter.type == CPX_PARAMTYPE_LONG)
+		cplex::setlongparam(env, parameter.number, parameter.integer_value);
+	else if (parameter.type == CPX_PARAMTYPE_DOUBLE)
+		cplex::setdblparam(env, parameter.number, parameter.double_value);
+	else if (parameter.type == CPX_PARAMTYPE_STRING)
+		cplex::setstrparam(env, parameter.number, parameter.string_value.c_str());
+}
+}
+
+bool CplexParameter::operator==(const CplexParameter& parameter) const
+{
+	return number == parameter.number && type == parameter.type && integer_value == parameter.integer_value &&
+		double_value == parameter.double_value && string_value == parameter.string_value;
+}
+
+bool CplexParameter::operator!=(const CplexParameter& parameter) const
+{
+	return !(*this == parameter);
+}
+
+CplexConfiguration::CplexConfiguration(CPXENVptr env, const json& config)
+{
+	for (auto it_param = config.begin(); it_param != config.end(); ++it_param)
+	{
+		string param_name = it_param.key();
+		CplexParameter parameter{0, 0, 0, 0.0, ""};
+		cplex::getparamnum(env, param_name.c_str(), &parameter.number);
+		cplex::getparamtype(env, parameter.number, &parameter.type);
+		
+		if (parameter.type == CPX_PARAMTYPE_INT || parameter.type == CPX_PARAMTYPE_LONG)
+			parameter.integer_value = it_param.value();
+		else if (parameter.type == CPX_PARAMTYPE_DOUBLE)
+			parameter.double_value = it_param.value();
+		else if (parameter.type == CPX_PARAMTYPE_STRING)
+			parameter.string_value = STR(it_param.value());
+		else fail("Unrecognized CPLEX parameter: " + param_name);
+		SetParameter(parameter);
+	}
+}
+
+void CplexConfiguration::SetIntParameter(int number, CPXINT value)
+{
+	SetParameter({number, CPX_PARAMTYPE_INT, value, 0.0, ""});
+}
+
+void CplexConfiguration::SetDoubleParameter(int number, double value)
+{
+	SetParameter({number, CPX_PARAMTYPE_DOUBLE, 0, value, ""});
+}
+
+const vector<CplexParameter>& CplexConfiguration::Parameters() const
+{
+	return parameters_;
+}
+
+void CplexConfiguration::Apply(CPXENVptr env, CplexConfiguration* applied) const
+{
+	// Check if some parameter applied must go back to its default value.
+	bool reset_needed = false;
+	int i = 0;
+	for (auto& parameter: applied->parameters_)
+	{
+		while (i < parameters_.size() && parameters_[i].number < parameter.number) ++i;
+		if (i == parameters_.size() || parameters_[i].number != parameter.number) { reset_needed = true; break; }
+	}
+	
+	// Send all the parameters after a reset, otherwise only the ones that changed.
+	if (reset_needed)
+	{
+		cplex::setdefaults(env);
+		for (auto& parameter: parameters_) apply_parameter(env, parameter);
+	}
+	else
+	{
+		int j = 0;
+		for (auto& parameter: parameters_)
+		{
+			while (j < applied->parameters_.size() && applied->parameters_[j].number < parameter.number) ++j;
+			if (j < applied->parameters_.size() && applied->parameters_[j] == parameter) continue;
+			apply_parameter(env, parameter);
+		}
+	}
+	applied->parameters_ = parameters_;
+}
+
+void CplexConfiguration::SetParameter(const CplexParameter& parameter)
+{
+	auto it = lower_bound(parameters_.begin(), parameters_.end(), parameter,
+		[] (const CplexParameter& p1, const CplexParameter& p2) { return p1.number < p2.number; });
+	if (it != parameters_.end() && it->number == parameter.number) *it = parameter;
+	else parameters_.insert(it, parameter);
+}
+} // namespace goc
@@ -25,28 +25,46 @@ struct CplexRow
 	double rhs;
 	char sense;
 	vector<int> rmatbeg, rmatind;
-	vector<double> rmatval;
+	const double* rmatval; // points to the coefficients of the constraint (it must outlive the row).
 };
 
+// Returns: the CPLEX character representing the domain of a variable.
+char cplex_domain(VariableDomain domain)
+{
+	switch (domain)
+	{
+		case VariableDomain::Real: return 'C';
+		case VariableDomain::Integer: return 'I';
+		case VariableDomain::Binary: return 'B';
+	}
+	fail("Unrecognized variable domain.");
+	return 'C';
+}
+
+// Returns: the CPLEX bound representing 'bound' (INFTY and -INFTY are mapped to the CPLEX infinite bounds).
+double cplex_bound(double bound)
+{
+	if (bound == INFTY) return CPX_INFBOUND;
+	if (bound == -INFTY) return -CPX_INFBOUND;
+	return bound;
+}
+
 // Returns: a CPLEX row representing the constraint.
 // Precondition: constraint must be normalized.
+// Observation: the coefficients are read directly from the constraint, so the row is valid while the constraint lives.
 CplexRow constraint_to_cplex_row(const Constraint& constraint)
 {
 	CplexRow row;
-	
-	map<enum Constraint::Sense, char> cplex_senses = {{Constraint::LessEqual, 'L'}, {Constraint::GreaterEqual, 'G'},
-													  {Constraint::Equality, 'E'}};
-	row.nzcnt = constraint.LeftSide().NonZeroVariableTermCount();
+	const Expression& left_side = constraint.LeftSide();
+	const vector<Variable>& variables = left_side.Variables();
+	const vector<double>& coefficients = left_side.Coefficients();
+	row.nzcnt = row.nzind = variables.size();
 	row.rhs = constraint.RightSide();
-	row.sense = cplex_senses[constraint.Sense()];
-	row.rmatbeg.push_back(0);
-	row.nzind = 0;
-	for (auto& term: constraint.LeftSide().Terms())
-	{
-		row.rmatind.push_back(term.first.Index());
-		row.rmatval.push_back(term.second);
-		row.nzind++;
-	}
+	row.sense = cplex::sense(constraint.Sense());
+	row.rmatbeg = {0};
+	row.rmatind.resize(variables.size());
+	for (int i = 0; i < variables.size(); ++i) row.rmatind[i] = variables[i].Index();
+	row.rmatval = coefficients.data();
 	return row;
 }
 }
@@ -58,37 +76,84 @@ CplexFormulation::CplexFormulation()
 		cplex::closeCPLEX(&env_p);
 	});
 	env_ = env_memory_handler_.get();
+	applied_configuration_ = make_shared<CplexConfiguration>();
 	problem_ = cplex::createprob(env_, "formulation");
+	relaxation_ = nullptr;
 }
 
 CplexFormulation::~CplexFormulation()
 {
 	cplex::freeprob(env_, &problem_);
-	for (int* i: variable_indices_) delete i;
+	if (relaxation_) cplex::freeprob(env_, &relaxation_);
+	for (VariableEntry* entry: variable_entries_) entry_pool_.Delete(entry);
 }
 
 int CplexFormulation::AddConstraint(const Constraint& constraint)
 {
 	// Add constraint to CPLEX formulation.
 	auto cplex_row = constraint_to_cplex_row(constraint);
-	cplex::addrows(env_, problem_, 0, 1, cplex_row.nzind, &cplex_row.rhs, &cplex_row.sense, &cplex_row.rmatbeg[0], &cplex_row.rmatind[0], &cplex_row.rmatval[0], nullptr, nullptr);
+	cplex::addrows(env_, problem_, 0, 1, cplex_row.nzind, &cplex_row.rhs, &cplex_row.sense, &cplex_row.rmatbeg[0], &cplex_row.rmatind[0], cplex_row.rmatval, nullptr, nullptr);
+	if (relaxation_) cplex::addrows(env_, relaxation_, 0, 1, cplex_row.nzind, &cplex_row.rhs, &cplex_row.sense, &cplex_row.rmatbeg[0], &cplex_row.rmatind[0], cplex_row.rmatval, nullptr, nullptr);
 	
 	return ConstraintCount()-1;
 }
 
+pair<int, int> CplexFormulation::AddConstraints(const vector<Constraint>& constraints)
+{
+	// Pack all constraints in a single CSR block.
+	int nonzero_count = 0;
+	for (auto& constraint: constraints) nonzero_count += constraint.LeftSide().NonZeroVariableTermCount();
+	RowBuilder rows;
+	rows.Reserve(constraints.size(), nonzero_count);
+	for (auto& constraint: constraints) rows.AddRow(constraint);
+	return AddConstraints(rows);
+}
+
+pair<int, int> CplexFormulation::AddConstraints(const RowBuilder& rows)
+{
+	int first = ConstraintCount();
+	if (rows.RowCount() == 0) return {first, first-1};
+	
+	// Add all rows to CPLEX with a single call.
+	vector<char> senses(rows.RowCount());
+	for (int i = 0; i < rows.RowCount(); ++i) senses[i] = cplex::sense(rows.Senses()[i]);
+	cplex::addrows(env_, problem_, 0, rows.RowCount(), rows.NonZeroCount(), rows.RightSides().data(), senses.data(),
+		rows.RowBegin().data(), rows.ColumnIndices().data(), rows.Values().data(), nullptr, nullptr);
+	if (relaxation_)
+		cplex::addrows(env_, relaxation_, 0, rows.RowCount(), rows.NonZeroCount(), rows.RightSides().data(),
+			senses.data(), rows.RowBegin().data(), rows.ColumnIndices().data(), rows.Values().data(), nullptr, nullptr);
+	
+	return {first, ConstraintCount()-1};
+}
+
 void CplexFormulation::RemoveConstraint(int constraint_index)
 {
-	// Remove constraint from CPLEX.
+	if (constraint_index < 0 || constraint_index >= ConstraintCount()) return;
 	cplex::delrows(env_, problem_, constraint_index, constraint_index);
+	if (relaxation_) cplex::delrows(env_, relaxation_, constraint_index, constraint_index);
+}
+
+void CplexFormulation::RemoveConstraints(const vector<int>& constraint_indices)
+{
+	// Mark the rows to remove.
+	int constraint_count = ConstraintCount();
+	vector<int> delstat(constraint_count, 0);
+	bool any_removed = false;
+	for (int i: constraint_indices)
+	{
+		if (i < 0 || i >= constraint_count) continue;
+		delstat[i] = 1;
+		any_removed = true;
+	}
+	if (!any_removed) return;
 	
-	// Reduce all constraints indices following 'constraint_id' by one.
-	for (int i = constraint_index; i < constraint_indices_.size()-1; ++i)
+	// Remove all rows from CPLEX with a single call (delstat is overwritten by CPLEX, so the relaxation needs a copy).
+	if (relaxation_)
 	{
-		swap(constraint_indices_[i], constraint_indices_[i+1]);
-		*constraint_indices_[i] = i;
+		vector<int> relaxation_delstat = delstat;
+		cplex::delsetrows(env_, relaxation_, relaxation_delstat.data());
 	}
-	delete constraint_indices_.back();
-	constraint_indices_.pop_back();
+	cplex::delsetrows(env_, problem_, delstat.data());
 }
 
 void CplexFormulation::AddLazyConstraint(SeparationRoutine* lazy_constraint)
@@ -106,47 +171,110 @@ void CplexFormulation::RemoveLazyConstraint(SeparationRoutine* lazy_constraint)
 Variable CplexFormulation::AddVariable(const string& name, VariableDomain domain, double lower_bound, double upper_bound)
 {
 	// Add variable to internal structure.
-	variable_indices_.push_back(new int(variable_indices_.size()));
-	variable_names_.push_back(name);
+	variable_entries_.push_back(entry_pool_.New((int)variable_entries_.size(), name));
 	
-	// Add variable to CPLEX.
-	char* colname[] = {(char*)variable_names_.back().c_str()};
-	cplex::newcols(env_, problem_, 1, nullptr, nullptr, nullptr, nullptr, colname);
+	// Add variable to CPLEX with its domain and bounds in a single call.
+	// Observation: continuous variables are added without type, so LP problems are not turned into MIP problems.
+	char* colname[] = {(char*)variable_entries_.back()->name.c_str()};
+	double lb[] = {cplex_bound(lower_bound)}, ub[] = {cplex_bound(upper_bound)};
+	char xctype[] = {cplex_domain(domain)};
+	cplex::newcols(env_, problem_, 1, nullptr, lb, ub, domain == VariableDomain::Real ? nullptr : xctype, colname);
+	if (relaxation_) cplex::newcols(env_, relaxation_, 1, nullptr, lb, ub, nullptr, colname);
 	
-	Variable var(name, variable_indices_.back());
+	return Variable(variable_entries_.back());
+}
+
+vector<Variable> CplexFormulation::AddColumns(const ColumnBuilder& columns)
+{
+	int first = VariableCount(), column_count = columns.ColumnCount();
+	if (column_count == 0) return {};
 	
-	// Set variable domain.
-	SetVariableDomain(var, domain);
+	// Add variables to internal structure.
+	vector<char*> colname(column_count);
+	vector<double> lb(column_count), ub(column_count);
+	for (int j = 0; j < column_count; ++j)
+	{
+		variable_entries_.push_back(entry_pool_.New(first + j, columns.Names()[j]));
+		colname[j] = (char*)variable_entries_.back()->name.c_str();
+		lb[j] = cplex_bound(columns.LowerBounds()[j]);
+		ub[j] = cplex_bound(columns.UpperBounds()[j]);
+	}
 	
-	// Set bounds.
-	SetVariableBound(var, lower_bound, upper_bound);
+	// Add all columns to CPLEX with a single call.
+	cplex::addcols(env_, problem_, column_count, columns.NonZeroCount(), columns.ObjectiveCoefficients().data(),
+		columns.ColumnBegin().data(), columns.RowIndices().data(), columns.Values().data(), lb.data(), ub.data(),
+		colname.data());
+	if (relaxation_)
+		cplex::addcols(env_, relaxation_, column_count, columns.NonZeroCount(), columns.ObjectiveCoefficients().data(),
+			columns.ColumnBegin().data(), columns.RowIndices().data(), columns.Values().data(), lb.data(), ub.data(),
+			colname.data());
 	
-	return var;
+	// Set the domains only if there are non continuous columns (CPLEX adds them as continuous).
+	vector<int> indices;
+	vector<char> xctype;
+	for (int j = 0; j < column_count; ++j)
+	{
+		if (columns.Domains()[j] == VariableDomain::Real) continue;
+		indices.push_back(first + j);
+		xctype.push_back(cplex_domain(columns.Domains()[j]));
+	}
+	if (!indices.empty()) cplex::chgctype(env_, problem_, indices.size(), indices.data(), xctype.data());
+	
+	vector<Variable> variables;
+	variables.reserve(column_count);
+	for (int j = 0; j < column_count; ++j) variables.push_back(VariableAtIndex(first + j));
+	return variables;
 }
 
 void CplexFormulation::RemoveVariable(const Variable& variable)
 {
-	// Remove variable from CPLEX.
-	cplex::delcols(env_, problem_, variable.Index(), variable.Index());
+	RemoveVariables({variable});
+}
+
+void CplexFormulation::RemoveVariables(const vector<Variable>& variables)
+{
+	// Mark the columns to remove.
+	vector<int> delstat(VariableCount(), 0);
+	bool any_removed = false;
+	for (const Variable& variable: variables)
+	{
+		if (variable.Index() < 0 || variable.Index() >= delstat.size()) continue;
+		delstat[variable.Index()] = 1;
+		any_removed = true;
+	}
+	if (!any_removed) return;
 	
-	// Reduce all variable indices following the erased variable by one and delete its name from the vector of names.
-	for (int i = variable.Index(); i < variable_indices_.size()-1; ++i)
+	// Remove all columns from CPLEX with a single call.
+	// Observation: CPLEX sets delstat[j] to the new index of column j, or -1 if it was removed.
+	if (relaxation_)
 	{
-		swap(variable_names_[i], variable_names_[i+1]);
-		swap(variable_indices_[i], variable_indices_[i+1]);
-		*variable_indices_[i] = i;
+		vector<int> relaxation_delstat = delstat;
+		cplex::delsetcols(env_, relaxation_, relaxation_delstat.data());
 	}
-	variable_names_.pop_back();
-	delete variable_indices_.back();
-	variable_indices_.pop_back();
+	cplex::delsetcols(env_, problem_, delstat.data());
+	
+	// Renumber the remaining entries and release the removed ones in a single pass.
+	int kept_count = 0;
+	for (int j = 0; j < delstat.size(); ++j)
+	{
+		if (delstat[j] == -1)
+		{
+			entry_pool_.Delete(variable_entries_[j]);
+			continue;
+		}
+		variable_entries_[kept_count] = variable_entries_[j];
+		variable_entries_[kept_count]->index = kept_count;
+		++kept_count;
+	}
+	variable_entries_.resize(kept_count);
 }
 
 void CplexFormulation::SetVariableDomain(const Variable& variable, VariableDomain domain)
 {
-	std::map<VariableDomain, char> cplex_domains = {{VariableDomain::Real, 'C'}, {VariableDomain::Integer, 'I'},
-													{VariableDomain::Binary, 'B'}};
+	// Continuous variables in an LP problem already have the domain, and setting it would turn the problem into a MIP.
+	if (domain == VariableDomain::Real && cplex::getprobtype(env_, problem_) == CPXPROB_LP) return;
 	int indices[] = {variable.Index()};
-	char xctype[] = {cplex_domains[domain]};
+	char xctype[] = {cplex_domain(domain)};
 	cplex::chgctype(env_, problem_, 1, indices, xctype);
 }
 
@@ -158,6 +286,7 @@ void CplexFormulation::SetVariableBound(const Variable& v, double lower_bound, d
 	double bd[] = {lower_bound, upper_bound};
 	char type[] = {'L', 'U'};
 	cplex::chgbds(env_, problem_, 2, indices, type, bd);
+	if (relaxation_) cplex::chgbds(env_, relaxation_, 2, indices, type, bd);
 }
 
 void CplexFormulation::SetVariableLowerBound(const Variable& v, double lower_bound)
@@ -167,6 +296,7 @@ void CplexFormulation::SetVariableLowerBound(const Variable& v, double lower_bou
 	double bd[] = {lower_bound};
 	char type[] = {'L'};
 	cplex::chgbds(env_, problem_, 1, indices, type, bd);
+	if (relaxation_) cplex::chgbds(env_, relaxation_, 1, indices, type, bd);
 }
 
 void CplexFormulation::SetVariableUpperBound(const Variable& v, double upper_bound)
@@ -176,50 +306,58 @@ void CplexFormulation::SetVariableUpperBound(const Variable& v, double upper_bou
 	double bd[] = {upper_bound};
 	char type[] = {'U'};
 	cplex::chgbds(env_, problem_, 1, indices, type, bd);
+	if (relaxation_) cplex::chgbds(env_, relaxation_, 1, indices, type, bd);
 }
 
 void CplexFormulation::Minimize(const Expression& objective_function)
 {
 	vector<int> indices = range(0, VariableCount());
 	vector<double> values(VariableCount(), 0.0);
-	int i = 0;
-	for (auto& term: objective_function.Terms())
-	{
-		values[term.first.Index()] = term.second;
-		++i;
-	}
+	const vector<Variable>& variables = objective_function.Variables();
+	const vector<double>& coefficients = objective_function.Coefficients();
+	for (int i = 0; i < variables.size(); ++i) values[variables[i].Index()] = coefficients[i];
 	cplex::chgobj(env_, problem_, VariableCount(), &indices[0], &values[0]);
 	cplex::chgobjsen(env_, problem_, CPX_MIN);
+	if (relaxation_)
+	{
+		cplex::chgobj(env_, relaxation_, VariableCount(), &indices[0], &values[0]);
+		cplex::chgobjsen(env_, relaxation_, CPX_MIN);
+	}
 }
 
 void CplexFormulation::Maximize(const Expression& objective_function)
 {
 	vector<int> indices = range(0, VariableCount());
 	vector<double> values(VariableCount(), 0.0);
-	int i = 0;
-	for (auto& term: objective_function.Terms())
-	{
-		values[term.first.Index()] = term.second;
-		++i;
-	}
+	const vector<Variable>& variables = objective_function.Variables();
+	const vector<double>& coefficients = objective_function.Coefficients();
+	for (int i = 0; i < variables.size(); ++i) values[variables[i].Index()] = coefficients[i];
 	cplex::chgobj(env_, problem_, VariableCount(), &indices[0], &values[0]);
 	cplex::chgobjsen(env_, problem_, CPX_MAX);
+	if (relaxation_)
+	{
+		cplex::chgobj(env_, relaxation_, VariableCount(), &indices[0], &values[0]);
+		cplex::chgobjsen(env_, relaxation_, CPX_MAX);
+	}
 }
 
 void CplexFormulation::SetConstraintRightHandSide(int constraint_index, double value)
 {
 	cplex::chgrhs(env_, problem_, 1, &constraint_index, &value);
+	if (relaxation_) cplex::chgrhs(env_, relaxation_, 1, &constraint_index, &value);
 }
 
 void CplexFormulation::SetConstraintCoefficient(int constraint_index, const Variable& variable, double coefficient)
 {
 	cplex::chgcoef(env_, problem_, constraint_index, variable.Index(), coefficient);
+	if (relaxation_) cplex::chgcoef(env_, relaxation_, constraint_index, variable.Index(), coefficient);
 }
 
 void CplexFormulation::SetObjectiveCoefficient(const Variable& variable, double coefficient)
 {
 	int indices[] = {variable.Index()};
 	cplex::chgobj(env_, problem_, 1, indices, &coefficient);
+	if (relaxation_) cplex::chgobj(env_, relaxation_, 1, indices, &coefficient);
 }
 
 Formulation::ObjectiveSense CplexFormulation::GetObjectiveSense() const
@@ -250,6 +388,8 @@ double CplexFormulation::GetConstraintCoefficient(int constraint_index, const Va
 
 VariableDomain CplexFormulation::GetVariableDomain(const Variable& variable) const
 {
+	// LP problems have no types, all their variables are continuous.
+	if (cplex::getprobtype(env_, problem_) == CPXPROB_LP) return VariableDomain::Real;
 	char type;
 	cplex::getctype(env_, problem_, &type, variable.Index(), variable.Index());
 	
@@ -273,14 +413,14 @@ Expression CplexFormulation::ObjectiveFunction() const
 	vector<double> coefficients(VariableCount());
 	cplex::getobj(env_, problem_, &coefficients[0], 0, VariableCount()-1);
 	Expression obj;
-	for (int i = 0; i < VariableCount(); ++i) obj += coefficients[i] * Variable(variable_names_[i], variable_indices_[i]);
+	for (int i = 0; i < VariableCount(); ++i) obj += coefficients[i] * Variable(variable_entries_[i]);
 	return obj;
 }
 
 vector<Variable> CplexFormulation::Variables() const
 {
 	vector<Variable> variables;
-	for (int i = 0; i < VariableCount(); ++i) variables.push_back({variable_names_[i], variable_indices_[i]});
+	for (int i = 0; i < VariableCount(); ++i) variables.push_back(Variable(variable_entries_[i]));
 	return variables;
 }
 
@@ -290,19 +430,17 @@ vector<Constraint> CplexFormulation::Constraints() const
 	int variable_count = VariableCount();
 	
 	// Set buffer sizes.
-	CplexRow row;
-	row.rmatbeg.assign(1,0);
-	row.rmatind.assign(variable_count, 0);
-	row.rmatval.assign(variable_count, 0.0);
-	int surplus = 0;
+	int nzcnt, rmatbeg = 0, surplus = 0;
+	vector<int> rmatind(variable_count, 0);
+	vector<double> rmatval(variable_count, 0.0);
 	for (int i = 0; i < ConstraintCount(); ++i)
 	{
 		// Get i-th row from CPLEX.
-		cplex::getrows(env_, problem_, &row.nzcnt, &row.rmatbeg[0], &row.rmatind[0], &row.rmatval[0], variable_count, &surplus, i, i);
+		cplex::getrows(env_, problem_, &nzcnt, &rmatbeg, &rmatind[0], &rmatval[0], variable_count, &surplus, i, i);
 		
 		// Create constraint with row values.
 		Expression left;
-		for (int j = 0; j < row.nzcnt; ++j) left += row.rmatval[j] * VariableAtIndex(row.rmatind[j]);
+		for (int j = 0; j < nzcnt; ++j) left += rmatval[j] * VariableAtIndex(rmatind[j]);
 		double right = GetConstraintRightHandSide(i);
 		char sense;
 		cplex::getsense(env_, problem_, &sense, i, i);
@@ -313,6 +451,58 @@ vector<Constraint> CplexFormulation::Constraints() const
 	return constraints;
 }
 
+void CplexFormulation::GetColumns(const vector<Variable>& variables, ColumnBuilder* columns) const
+{
+	if (variables.empty()) return;
+	
+	// Get the range of columns that includes all the variables from CPLEX, with one call for each attribute.
+	int begin = variables[0].Index(), end = variables[0].Index();
+	for (auto& variable: variables)
+	{
+		begin = min(begin, variable.Index());
+		end = max(end, variable.Index());
+	}
+	int count = end - begin + 1, nonzero_count = cplex::getnumnz(env_, problem_), nzcnt = 0, surplus = 0;
+	vector<int> cmatbeg(count, 0), cmatind(max(nonzero_count, 1), 0);
+	vector<double> cmatval(max(nonzero_count, 1), 0.0), obj(count), lb(count), ub(count);
+	cplex::getcols(env_, problem_, &nzcnt, cmatbeg.data(), cmatind.data(), cmatval.data(), nonzero_count, &surplus,
+		begin, end);
+	cplex::getobj(env_, problem_, obj.data(), begin, end);
+	cplex::getlb(env_, problem_, lb.data(), begin, end);
+	cplex::getub(env_, problem_, ub.data(), begin, end);
+	
+	// LP problems have no types, all their variables are continuous.
+	vector<char> types(count, 'C');
+	if (cplex::getprobtype(env_, problem_) != CPXPROB_LP) cplex::getctype(env_, problem_, types.data(), begin, end);
+	std::map<char, VariableDomain> cplex_domains = {{'C', VariableDomain::Real}, {'I', VariableDomain::Integer},
+													{'B', VariableDomain::Binary}};
+	
+	for (auto& variable: variables)
+	{
+		int j = variable.Index() - begin;
+		int column_end = j + 1 < count ? cmatbeg[j + 1] : nzcnt;
+		for (int k = cmatbeg[j]; k < column_end; ++k) columns->AddTerm(cmatind[k], cmatval[k]);
+		columns->EndColumn(variable.Name(), obj[j], cplex_domains[types[j]], lb[j] == -CPX_INFBOUND ? -INFTY : lb[j],
+			ub[j] == CPX_INFBOUND ? INFTY : ub[j]);
+	}
+}
+
+void CplexFormulation::GetEmptyRows(RowBuilder* rows) const
+{
+	int constraint_count = ConstraintCount();
+	if (constraint_count == 0) return;
+	vector<double> rhs(constraint_count);
+	vector<char> senses(constraint_count);
+	cplex::getrhs(env_, problem_, rhs.data(), 0, constraint_count-1);
+	cplex::getsense(env_, problem_, senses.data(), 0, constraint_count-1);
+	for (int i = 0; i < constraint_count; ++i)
+	{
+		if (senses[i] == 'L') rows->EndRow(Constraint::LessEqual, rhs[i]);
+		else if (senses[i] == 'G') rows->EndRow(Constraint::GreaterEqual, rhs[i]);
+		else rows->EndRow(Constraint::Equality, rhs[i]);
+	}
+}
+
 const vector<SeparationRoutine*>& CplexFormulation::LazyConstraints() const
 {
 	return lazy_constraints_;
@@ -330,7 +520,7 @@ int CplexFormulation::ConstraintCount() const
 
 Variable CplexFormulation::VariableAtIndex(int variable_index) const
 {
-	return Variable(variable_names_[variable_index], variable_indices_[variable_index]);
+	return Variable(variable_entries_[variable_index]);
 }
 
 double CplexFormulation::EvaluateValuation(const Valuation& valuation) const
@@ -355,10 +545,10 @@ bool CplexFormulation::IsFeasibleValuation(const Valuation& v, bool verbose) con
 
 Formulation* CplexFormulation::Copy() const
 {
-	CplexFormulation* copy = new CplexFormulation(env_memory_handler_, cplex::cloneprob(env_, problem_));
-	copy->variable_names_ = variable_names_;
-	for (int i = 0; i < VariableCount(); ++i) copy->variable_indices_.push_back(new int(i));
-	for (int i = 0; i < ConstraintCount(); ++i) copy->constraint_indices_.push_back(new int(i));
+	CplexFormulation* copy = new CplexFormulation(env_memory_handler_, applied_configuration_,
+		cplex::cloneprob(env_, problem_));
+	if (relaxation_) copy->relaxation_ = cplex::cloneprob(env_, relaxation_);
+	for (VariableEntry* entry: variable_entries_) copy->variable_entries_.push_back(copy->entry_pool_.New(*entry));
 	copy->lazy_constraints_ = lazy_constraints_;
 	return copy;
 }
@@ -383,8 +573,26 @@ CPXLPptr CplexFormulation::Problem() const
 	return problem_;
 }
 
-CplexFormulation::CplexFormulation(const std::shared_ptr<cpxenv>& env_memory_handler, CPXLPptr problem)
-	: env_memory_handler_(env_memory_handler), env_(env_memory_handler.get()), problem_(problem)
+CplexConfiguration* CplexFormulation::AppliedConfiguration() const
+{
+	return applied_configuration_.get();
+}
+
+CPXLPptr CplexFormulation::Relaxation()
+{
+	if (relaxation_) return relaxation_;
+	if (cplex::getprobtype(env_, problem_) == CPXPROB_LP) return problem_;
+	
+	// Create a continuous clone of the problem, from now on it is updated along with the problem.
+	relaxation_ = cplex::cloneprob(env_, problem_);
+	cplex::chgprobtype(env_, relaxation_, CPXPROB_LP);
+	return relaxation_;
+}
+
+CplexFormulation::CplexFormulation(const std::shared_ptr<cpxenv>& env_memory_handler,
+	const std::shared_ptr<CplexConfiguration>& applied_configuration, CPXLPptr problem)
+	: env_memory_handler_(env_memory_handler), env_(env_memory_handler.get()),
+	  applied_configuration_(applied_configuration), problem_(problem), relaxation_(nullptr)
 {
 
 }
@@ -4,17 +4,17 @@
 // Departamento de Computacion - Universidad de Buenos Aires.
 //
 
-#include <mutex>
-
 #include "goc/collection/collection_utils.h"
 #include "goc/string/string_utils.h"
 #include "goc/exception/exception_utils.h"
 #include "goc/math/number_utils.h"
 #include "goc/time/stopwatch.h"
 #include "goc/linear_programming/cuts/separation_algorithm.h"
+#include "goc/linear_programming/cuts/separation_routine_executor.h"
 #include "goc/linear_programming/cplex/cplex_solver.h"
 #include "goc/linear_programming/cplex/cplex_wrapper.h"
 #include "goc/linear_programming/cplex/cplex_formulation.h"
+#include "goc/linear_programming/model/row_builder.h"
 
 using namespace std;
 using namespace nlohmann;
@@ -54,32 +54,6 @@ void untunnel_cplex_logs(CplexFormulation* formulation, const vector<ostream*>&
 	cplex::delfuncdest(formulation->Environment(), log, (void*) &streams, tunnel_message);
 }
 
-// Applies the configuration parameters specified in the config json to CPLEX environment.
-void apply_configuration(CplexFormulation* formulation, const json& config)
-{
-	// Reset parameters of the formulation to the default values.
-	cplex::setdefaults(formulation->Environment());
-	
-	// Add new parameters.
-	for (auto it_param = config.begin(); it_param != config.end(); ++it_param)
-	{
-		string param_name = it_param.key();
-		int whichparam, paramtype;
-		cplex::getparamnum(formulation->Environment(), param_name.c_str(), &whichparam);
-		cplex::getparamtype(formulation->Environment(), whichparam, &paramtype);
-		
-		if (paramtype == CPX_PARAMTYPE_INT)
-			cplex::setintparam(formulation->Environment(), whichparam, it_param.value());
-		else if (paramtype == CPX_PARAMTYPE_LONG)
-			cplex::setlongparam(formulation->Environment(), whichparam, it_param.value());
-		else if (paramtype == CPX_PARAMTYPE_DOUBLE)
-			cplex::setdblparam(formulation->Environment(), whichparam, it_param.value());
-		else if (paramtype == CPX_PARAMTYPE_STRING)
-			cplex::setstrparam(formulation->Environment(), whichparam, STR(it_param.value()).c_str());
-		else fail("Unrecognized CPLEX parameter: " + param_name);
-	}
-}
-
 // Adds the initial solutions provided to the formulation as MIPstarts.
 void add_initial_solutions(CplexFormulation* formulation, const vector<Valuation>& initial_solutions)
 {
@@ -132,12 +106,12 @@ void set_branch_priorities(CplexFormulation* formulation, const vector<BranchPri
 
 // Extract information about the execution of CPLEX after solving with lpopt and add it to the execution log if necessary.
 // Information being handled:
-//	* SimplexIterations, Status, IncumbentValue, Incumbent, Duals
+//	* SimplexIterations, Status, IncumbentValue, Incumbent, Duals, ReducedCosts
 void extract_cplex_lp_execution_info(CplexFormulation* formulation, LPExecutionLog* execution_log,
 	const unordered_set<LPOption>& options)
 {
 	CPXENVptr env = formulation->Environment();
-	CPXLPptr prob = formulation->Problem();
+	CPXLPptr prob = formulation->Relaxation();
 	
 	// Simplex iterations.
 	execution_log->simplex_iterations = cplex::getitcnt(env, prob);
@@ -171,10 +145,7 @@ void extract_cplex_lp_execution_info(CplexFormulation* formulation, LPExecutionL
 		{
 			vector<double> values = vector<double>(formulation->VariableCount(), 0.0);
 			cplex::solution(env, prob, nullptr, nullptr, &(values[0]), nullptr, nullptr, nullptr);
-			Valuation incumbent;
-			for (int i = 0; i < formulation->VariableCount(); ++i)
-				incumbent.SetValue(formulation->VariableAtIndex(i), values[i]);
-			execution_log->incumbent = incumbent;
+			execution_log->incumbent = ValuationView(values.data(), values.size(), formulation).ToValuation();
 		}
 	}
 	
@@ -185,6 +156,14 @@ void extract_cplex_lp_execution_info(CplexFormulation* formulation, LPExecutionL
 		cplex::getpi(env, prob, &(duals[0]), 0, formulation->ConstraintCount() - 1);
 		execution_log->duals = duals;
 	}
+	
+	// Reduced costs.
+	if (includes(options, LPOption::ReducedCosts))
+	{
+		vector<double> reduced_costs(formulation->VariableCount(), 0.0);
+		cplex::getdj(env, prob, &(reduced_costs[0]), 0, formulation->VariableCount() - 1);
+		execution_log->reduced_costs = reduced_costs;
+	}
 }
 
 // Extract information about the execution of CPLEX after solving with mipopt and add it to the execution log if necessary.
@@ -244,10 +223,7 @@ void extract_cplex_mip_execution_info(CplexFormulation* formulation, BCExecution
 		{
 			vector<double> values = vector<double>(formulation->VariableCount(), 0.0);
 			cplex::solution(env, prob, nullptr, nullptr, &(values[0]), nullptr, nullptr, nullptr);
-			Valuation best_int_solution;
-			for (int i = 0; i < formulation->VariableCount(); ++i)
-				best_int_solution.SetValue(formulation->VariableAtIndex(i), values[i]);
-			execution_log->best_int_solution = best_int_solution;
+			execution_log->best_int_solution = ValuationView(values.data(), values.size(), formulation).ToValuation();
 		}
 	}
 	
@@ -294,49 +270,39 @@ void extract_cplex_mip_execution_info(CplexFormulation* formulation, BCExecution
 // *** End extract information functions *** //
 
 // *** Callback functions *** //
-// The internal structure of CPLEX to store a constraint.
-struct CplexRow
+// Buffers used by a thread on each callback call. They are kept between calls to avoid allocating them every time.
+struct CallbackBuffers
 {
-	int nzcnt, nzind;
-	double rhs;
-	char sense;
-	vector<int> rmatbeg, rmatind;
-	vector<double> rmatval;
+	vector<double> point; // values of the variables in the relaxation or candidate point.
+	vector<int> support; // indices of the non-zero values of the point.
+	RowBuilder rows; // constraints to add in CSR format.
+	vector<char> senses; // CPLEX sense of each row.
+	vector<int> purgeable, local; // flags of each user cut.
 };
 
-// Returns: a CPLEX row representing the constraint.
-// Precondition: constraint must be normalized.
-CplexRow constraint_to_cplex_row(const Constraint& constraint)
+// Packs the constraints in the rows and senses of the buffers.
+// Precondition: constraints must be normalized.
+void pack_constraints(const vector<Constraint>& constraints, CallbackBuffers* buffers)
 {
-	CplexRow row;
-	
-	map<enum Constraint::Sense, char> cplex_senses = {{Constraint::LessEqual,    'L'},
-													  {Constraint::GreaterEqual, 'G'},
-													  {Constraint::Equality,     'E'}};
-	row.nzcnt = constraint.LeftSide().NonZeroVariableTermCount();
-	row.rhs = constraint.RightSide();
-	row.sense = cplex_senses[constraint.Sense()];
-	row.rmatbeg = {0};
-	row.nzind = 0;
-	for (auto& term: constraint.LeftSide().Terms())
+	buffers->rows.Clear();
+	buffers->senses.clear();
+	for (const Constraint& constraint: constraints)
 	{
-		row.rmatind.push_back(term.first.Index());
-		row.rmatval.push_back(term.second);
-		row.nzind++;
+		buffers->rows.AddRow(constraint);
+		buffers->senses.push_back(cplex::sense(constraint.Sense()));
 	}
-	return row;
 }
 
-std::mutex lazy_constraint_lock;
-
 int cplex_generic_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, void* userhandle)
 {
 	// Parse user handle infromation.
 	const SeparationAlgorithm* separation_algorithm;
+	const SeparationRoutineExecutor* lazy_executor;
 	CplexFormulation* formulation;
 	BCExecutionLog* execution_log;
-	tie(separation_algorithm, formulation,
-		execution_log) = *(tuple<const SeparationAlgorithm*, CplexFormulation*, BCExecutionLog*>*) userhandle;
+	tie(separation_algorithm, lazy_executor, formulation, execution_log) =
+		*(tuple<const SeparationAlgorithm*, const SeparationRoutineExecutor*, CplexFormulation*, BCExecutionLog*>*)
+		userhandle;
 	
 	// Vertex relaxation solved. Cuts may be introduced here.
 	if (contextid == CPX_CALLBACKCONTEXT_RELAXATION)
@@ -348,23 +314,24 @@ int cplex_generic_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, voi
 		CPXcallbackgetinfoint(context, CPXCALLBACKINFO_NODECOUNT, &nodes_solved);
 		
 		// Get relaxation point.
+		thread_local CallbackBuffers buffers;
 		double objective_value;
-		vector<double> relaxation_values(formulation->VariableCount());
-		cplex::callbackgetrelaxationpoint(context, &(relaxation_values[0]), 0, formulation->VariableCount() - 1,
+		buffers.point.resize(formulation->VariableCount());
+		cplex::callbackgetrelaxationpoint(context, buffers.point.data(), 0, formulation->VariableCount() - 1,
 										  &objective_value);
-		Valuation relaxation_point;
-		for (int i = 0; i < formulation->VariableCount(); ++i)
-			relaxation_point.SetValue(formulation->VariableAtIndex(i), relaxation_values[i]);
+		build_support(buffers.point.data(), buffers.point.size(), &buffers.support);
+		ValuationView relaxation_point(buffers.point.data(), buffers.point.size(), formulation, &buffers.support);
 		
-		// Cut relaxation point.
-		for (auto& cut: separation_algorithm->Separate(relaxation_point, nodes_solved, objective_value))
-		{
-			CplexRow row = constraint_to_cplex_row(cut);
-			int purgeable = CPX_USECUT_FORCE;
-			int local = 0;
-			cplex::callbackaddusercuts(context, 1, row.nzcnt, &row.rhs, &row.sense, &(row.rmatbeg[0]),
-									   &(row.rmatind[0]), &(row.rmatval[0]), &purgeable, &local);
-		}
+		// Cut relaxation point, all cuts are added with a single call.
+		pack_constraints(separation_algorithm->Separate(relaxation_point, nodes_solved, objective_value), &buffers);
+		if (buffers.rows.RowCount() == 0) return 0;
+		buffers.purgeable.assign(buffers.rows.RowCount(),
+			separation_algorithm->UsesCutPool() ? CPX_USECUT_PURGE : CPX_USECUT_FORCE);
+		buffers.local.assign(buffers.rows.RowCount(), 0);
+		cplex::callbackaddusercuts(context, buffers.rows.RowCount(), buffers.rows.NonZeroCount(),
+								   buffers.rows.RightSides().data(), buffers.senses.data(),
+								   buffers.rows.RowBegin().data(), buffers.rows.ColumnIndices().data(),
+								   buffers.rows.Values().data(), buffers.purgeable.data(), buffers.local.data());
 	}
 	// Integer solution found. Lazy constraints may be introduced here.
 	else if (contextid == CPX_CALLBACKCONTEXT_CANDIDATE)
@@ -375,30 +342,31 @@ int cplex_generic_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, voi
 		if (is_point == 0) return 0;
 		
 		// Get candidate solution.
-		vector<double> candidate_values(formulation->VariableCount());
+		thread_local CallbackBuffers buffers;
 		double node_bound;
-		cplex::callbackgetcandidatepoint(context, &(candidate_values[0]), 0, formulation->VariableCount() - 1, &node_bound);
-		Valuation candidate_point;
-		for (int i = 0; i < formulation->VariableCount(); ++i)
-			candidate_point.SetValue(formulation->VariableAtIndex(i), candidate_values[i]);
+		buffers.point.resize(formulation->VariableCount());
+		cplex::callbackgetcandidatepoint(context, buffers.point.data(), 0, formulation->VariableCount() - 1, &node_bound);
+		build_support(buffers.point.data(), buffers.point.size(), &buffers.support);
+		ValuationView candidate_point(buffers.point.data(), buffers.point.size(), formulation, &buffers.support);
 		
 		// Get nodes solved.
 		int nodes_solved;
 		CPXcallbackgetinfoint(context, CPXCALLBACKINFO_NODECOUNT, &nodes_solved);
 		
-		// Add lazy constraints that cut the candidate point.
+		// Find the lazy constraints that cut the candidate point, and reject it once with all of them.
+		// Routines only hold a lock when they are not thread safe, so candidates are checked in parallel.
+		vector<Constraint> violated_constraints;
 		for (const SeparationRoutine* lazy: formulation->LazyConstraints())
 		{
-			lazy_constraint_lock.lock();
-			auto violated_constraints = lazy->Separate(candidate_point, nodes_solved, INT_MAX, node_bound);
-			lazy_constraint_lock.unlock();
-			for (const Constraint& violated_constraint: violated_constraints)
-			{
-				CplexRow row = constraint_to_cplex_row(violated_constraint);
-				cplex::callbackrejectcandidate(context, 1, row.nzcnt, &row.rhs, &row.sense, &(row.rmatbeg[0]),
-											   &(row.rmatind[0]), &(row.rmatval[0]));
-			}
+			auto lazy_constraints = lazy_executor->Separate(lazy, candidate_point, nodes_solved, INT_MAX, node_bound);
+			violated_constraints.insert(violated_constraints.end(), lazy_constraints.begin(), lazy_constraints.end());
 		}
+		pack_constraints(violated_constraints, &buffers);
+		if (buffers.rows.RowCount() == 0) return 0;
+		cplex::callbackrejectcandidate(context, buffers.rows.RowCount(), buffers.rows.NonZeroCount(),
+									   buffers.rows.RightSides().data(), buffers.senses.data(),
+									   buffers.rows.RowBegin().data(), buffers.rows.ColumnIndices().data(),
+									   buffers.rows.Values().data());
 	}
 	else if (contextid == CPX_CALLBACKCONTEXT_GLOBAL_PROGRESS)
 	{
@@ -420,10 +388,7 @@ int cplex_generic_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, voi
 				execution_log->root_int_value = best_int_value;
 					vector<double> values = vector<double>(formulation->VariableCount(), 0.0);
 					cplex::callbackgetincumbent(context, &(values[0]), 0, formulation->VariableCount() - 1, nullptr);
-					Valuation best_solution;
-					for (int i = 0; i < formulation->VariableCount(); ++i)
-						best_solution.SetValue(formulation->VariableAtIndex(i), values[i]);
-					execution_log->root_int_solution = best_solution;
+					execution_log->root_int_solution = ValuationView(values.data(), values.size(), formulation).ToValuation();
 			}
 		}
 	}
@@ -433,8 +398,8 @@ int cplex_generic_callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, voi
 // *** End Callback functions *** //
 }
 
-LPExecutionLog solve_lp(CplexFormulation* formulation, ostream* screen_output, Duration time_limit, const json& config,
-			   const unordered_set<LPOption>& options)
+LPExecutionLog solve_lp(CplexFormulation* formulation, ostream* screen_output, Duration time_limit,
+						const CplexConfiguration& config, const unordered_set<LPOption>& options)
 {
 	LPExecutionLog execution_log;
 	
@@ -445,23 +410,15 @@ LPExecutionLog solve_lp(CplexFormulation* formulation, ostream* screen_output, D
 	if (screen_output) output_streams.push_back(screen_output);
 	tunnel_cplex_logs(formulation, output_streams);
 	
-	// Apply configurations.
-	apply_configuration(formulation, config);
+	// Apply configurations and time limit (only the parameters that changed since the last solve are sent).
+	CplexConfiguration solve_config = config;
+	solve_config.SetDoubleParameter(CPX_PARAM_TILIM, time_limit.Amount(DurationUnit::Seconds));
+	solve_config.SetIntParameter(CPX_PARAM_REDUCE, CPX_PREREDUCE_NOPRIMALORDUAL);
+	solve_config.Apply(formulation->Environment(), formulation->AppliedConfiguration());
 	
-	// Apply time limit.
-	cplex::setdblparam(formulation->Environment(), CPX_PARAM_TILIM, time_limit.Amount(DurationUnit::Seconds));
-	cplex::setintparam(formulation->Environment(), CPX_PARAM_REDUCE, CPX_PREREDUCE_NOPRIMALORDUAL);
-	
-	// Change problem to LP, but before save the domain of variables, because changing the problem type to LP erases
-	// them.
-	vector<VariableDomain> variable_domains(formulation->VariableCount());
-	for (int i = 0; i < formulation->VariableCount(); ++i)
-		variable_domains[i] = formulation->GetVariableDomain(formulation->VariableAtIndex(i));
-	cplex::chgprobtype(formulation->Environment(), formulation->Problem(), CPXPROB_LP);
-	
-	// Optimize.
+	// Optimize the continuous relaxation, which keeps the basis of the previous solve as a warm start.
 	Stopwatch rolex(true);
-	cplex::lpopt(formulation->Environment(), formulation->Problem());
+	cplex::lpopt(formulation->Environment(), formulation->Relaxation());
 	rolex.Pause();
 	
 	// Remove CPLEX log tunneling from the formulation.
@@ -472,14 +429,11 @@ LPExecutionLog solve_lp(CplexFormulation* formulation, ostream* screen_output, D
 	if (includes(options, LPOption::ScreenOutput)) execution_log.screen_output = log_stream.str();
 	extract_cplex_lp_execution_info(formulation, &execution_log, options);
 	
-	// Return the variable domain to all variables.
-	for (int i = 0; i < formulation->VariableCount(); ++i)
-		formulation->SetVariableDomain(formulation->VariableAtIndex(i), variable_domains[i]);
-	
 	return execution_log;
 }
 
-BCExecutionLog solve_bc(CplexFormulation* formulation, ostream* screen_output, Duration time_limit, const json& config,
+BCExecutionLog solve_bc(CplexFormulation* formulation, ostream* screen_output, Duration time_limit,
+						const CplexConfiguration& config,
 						const vector<Valuation>& initial_solutions, const vector<BranchPriority>& branch_priorities,
 						const SeparationStrategy& separation_strategy, const unordered_set<BCOption>& options)
 {
@@ -499,23 +453,26 @@ BCExecutionLog solve_bc(CplexFormulation* formulation, ostream* screen_output, D
 	if (!formulation->LazyConstraints().empty()) context_mask |= CPX_CALLBACKCONTEXT_CANDIDATE;
 	if (includes(options, BCOption::RootInformation))
 		context_mask |= CPX_CALLBACKCONTEXT_GLOBAL_PROGRESS;
-	tuple<const SeparationAlgorithm*, CplexFormulation*, BCExecutionLog*> handle = {&separation_algorithm, formulation,
-																			&execution_log};
+	SeparationRoutineExecutor lazy_executor(vector<const SeparationRoutine*>(formulation->LazyConstraints().begin(),
+		formulation->LazyConstraints().end()));
+	tuple<const SeparationAlgorithm*, const SeparationRoutineExecutor*, CplexFormulation*, BCExecutionLog*> handle =
+		{&separation_algorithm, &lazy_executor, formulation, &execution_log};
 	cplex::callbacksetfunc(formulation->Environment(), formulation->Problem(), context_mask, cplex_generic_callback,
 						   &handle);
 	
-	// Apply configurations.
-	apply_configuration(formulation, config);
+	// Apply configurations (only the parameters that changed since the last solve are sent).
+	CplexConfiguration solve_config = config;
 	
 	// Deactivate reductions and keep solutions in original space if cuts are present.
 	if (separation_algorithm.IsEnabled())
 	{
-		cplex::setintparam(formulation->Environment(), CPX_PARAM_MIPCBREDLP, CPX_OFF);
-		cplex::setintparam(formulation->Environment(), CPX_PARAM_REDUCE, CPX_PREREDUCE_PRIMALONLY);
+		solve_config.SetIntParameter(CPX_PARAM_MIPCBREDLP, CPX_OFF);
+		solve_config.SetIntParameter(CPX_PARAM_REDUCE, CPX_PREREDUCE_PRIMALONLY);
 	}
 	
 	// Apply time limit.
-	cplex::setdblparam(formulation->Environment(), CPX_PARAM_TILIM, time_limit.Amount(DurationUnit::Seconds));
+	solve_config.SetDoubleParameter(CPX_PARAM_TILIM, time_limit.Amount(DurationUnit::Seconds));
+	solve_config.Apply(formulation->Environment(), formulation->AppliedConfiguration());
 	
 	// Set problem type to integer and set all variable domains.
 	cplex::chgprobtype(formulation->Environment(), formulation->Problem(), CPXPROB_MILP);
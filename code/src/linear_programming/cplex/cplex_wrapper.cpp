@@ -98,6 +98,16 @@ newcols(CPXENVptr env, CPXLPptr lp, int ccnt, double const* obj, double const* l
 	}
 }
 
+void addcols(CPXENVptr env, CPXLPptr lp, int ccnt, int nzcnt, double const* obj, int const* cmatbeg,
+			 int const* cmatind, double const* cmatval, double const* lb, double const* ub, char** colname)
+{
+	int status = CPXaddcols(env, lp, ccnt, nzcnt, obj, cmatbeg, cmatind, cmatval, lb, ub, colname);
+	if (status != 0)
+	{
+		fail_with_error_message(env, status, "CPXaddcols");
+	}
+}
+
 void delcols(CPXCENVptr env, CPXLPptr lp, int begin, int end)
 {
 	int status = CPXdelcols(env, lp, begin, end);
@@ -107,6 +117,15 @@ void delcols(CPXCENVptr env, CPXLPptr lp, int begin, int end)
 	}
 }
 
+void delsetcols(CPXENVptr env, CPXLPptr lp, int* delstat)
+{
+	int status = CPXdelsetcols(env, lp, delstat);
+	if (status != 0)
+	{
+		fail_with_error_message(env, status, "CPXdelsetcols");
+	}
+}
+
 void chgctype(CPXENVptr env, CPXLPptr lp, int cnt, int const* indices, char const* xctype)
 {
 	int status = CPXchgctype(env, lp, cnt, indices, xctype);
@@ -257,6 +276,15 @@ void delrows(CPXENVptr env, CPXLPptr lp, int begin, int end)
 	}
 }
 
+void delsetrows(CPXENVptr env, CPXLPptr lp, int* delstat)
+{
+	int status = CPXdelsetrows(env, lp, delstat);
+	if (status != 0)
+	{
+		fail_with_error_message(env, status, "CPXdelsetrows");
+	}
+}
+
 CPXLPptr cloneprob(CPXENVptr env, CPXCLPptr lp)
 {
 	int status;
@@ -363,6 +391,16 @@ void getrows(CPXCENVptr env, CPXCLPptr lp, int* nzcnt_p, int* rmatbeg, int* rmat
 	}
 }
 
+void getcols(CPXCENVptr env, CPXCLPptr lp, int* nzcnt_p, int* cmatbeg, int* cmatind, double* cmatval, int cmatspace,
+			 int* surplus_p, int begin, int end)
+{
+	int status = CPXgetcols(env, lp, nzcnt_p, cmatbeg, cmatind, cmatval, cmatspace, surplus_p, begin, end);
+	if (status != 0)
+	{
+		fail_with_error_message(env, status, "CPXgetcols");
+	}
+}
+
 void setintparam(CPXENVptr env, int whichparam, CPXINT newvalue)
 {
 	int status = CPXsetintparam(env, whichparam, newvalue);
@@ -595,6 +633,11 @@ int getnumcols(CPXENVptr env, CPXCLPptr lp)
 	return CPXgetnumcols(env, lp);
 }
 
+int getnumnz(CPXENVptr env, CPXCLPptr lp)
+{
+	return CPXgetnumnz(env, lp);
+}
+
 void copyorder(CPXENVptr env, CPXLPptr lp, int cnt, int const* indices, int const* priority,
 							 int const* direction)
 {
@@ -810,5 +853,17 @@ void getbase(CPXCENVptr env, CPXCLPptr lp, int* cstat, int* rstat)
 		fail_with_error_message(env, status, "CPXgetbase");
 	}
 }
+
+char sense(enum Constraint::Sense sense)
+{
+	switch (sense)
+	{
+		case Constraint::LessEqual: return 'L';
+		case Constraint::GreaterEqual: return 'G';
+		case Constraint::Equality: return 'E';
+	}
+	fail("Unrecognized constraint sense.");
+	return 'E';
+}
 } // namespace cplex
 } // namespace goc
\ No newline at end of file
@@ -0,0 +1,144 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/cuts/cut_pool.h"
+
+#include <functional>
+
+using namespace std;
+
+namespace goc
+{
+namespace
+{
+// Combines the hash h with the value hash v.
+void hash_combine(size_t* h, size_t v)
+{
+	*h ^= v + 0x9e3779b9 + (*h << 6) + (*h >> 2);
+}
+
+// Returns: a hash of the terms, sense and right hand side of the cut.
+size_t hash_cut(const Constraint& cut)
+{
+	size_t h = hash<int>()(cut.Sense());
+	hash_combine(&h, hash<double>()(cut.RightSide()));
+	const vector<Variable>& variables = cut.LeftSide().Variables();
+	const vector<double>& coefficients = cut.LeftSide().Coefficients();
+	for (int i = 0; i < variables.size(); ++i)
+	{
+		hash_combine(&h, hash<Variable>()(variables[i]));
+		hash_combine(&h, hash<double>()(coefficients[i]));
+	}
+	return h;
+}
+
+// Returns: if both cuts have the same terms, sense and right hand side.
+bool equal_cuts(const Constraint& c1, const Constraint& c2)
+{
+	return c1.Sense() == c2.Sense() && c1.RightSide() == c2.RightSide() &&
+		c1.LeftSide().Variables() == c2.LeftSide().Variables() &&
+		c1.LeftSide().Coefficients() == c2.LeftSide().Coefficients();
+}
+}
+
+CutPool::Entry::Entry(const Constraint& cut, size_t hash) : cut(cut), hash(hash), age(0)
+{ }
+
+CutPool::Entry::Entry(Entry&& entry) : cut(move(entry.cut)), hash(entry.hash), age(entry.age.load())
+{ }
+
+CutPool::Entry& CutPool::Entry::operator=(Entry&& entry)
+{
+	cut = move(entry.cut);
+	hash = entry.hash;
+	age = entry.age.load();
+	return *this;
+}
+
+CutPool::CutPool(int age_limit) : age_limit_(age_limit)
+{ }
+
+bool CutPool::Add(const Constraint& cut)
+{
+	size_t h = hash_cut(cut);
+	unique_lock<shared_timed_mutex> guard(lock_);
+	auto range = index_.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (equal_cuts(entries_[it->second].cut, cut))
+			return false;
+	
+	index_.insert({h, (int)entries_.size()});
+	entries_.emplace_back(cut, h);
+	return true;
+}
+
+vector<Constraint> CutPool::Separate(const Valuation& solution, int count_limit)
+{
+	return SeparateSolution(solution, count_limit);
+}
+
+vector<Constraint> CutPool::Separate(const ValuationView& solution, int count_limit)
+{
+	return SeparateSolution(solution, count_limit);
+}
+
+int CutPool::Size() const
+{
+	shared_lock<shared_timed_mutex> guard(lock_);
+	return entries_.size();
+}
+
+void CutPool::Clear()
+{
+	unique_lock<shared_timed_mutex> guard(lock_);
+	entries_.clear();
+	index_.clear();
+}
+
+template<typename ValuationType>
+vector<Constraint> CutPool::SeparateSolution(const ValuationType& solution, int count_limit)
+{
+	// Check all cuts and age the ones not violated. Other threads might be checking the pool too, so ages are only
+	// changed atomically and old cuts are removed later.
+	vector<Constraint> violated_cuts;
+	bool has_old_cuts = false;
+	{
+		shared_lock<shared_timed_mutex> guard(lock_);
+		for (auto& entry: entries_)
+		{
+			if (!entry.cut.Holds(solution))
+			{
+				entry.age = 0;
+				if (violated_cuts.size() < count_limit) violated_cuts.push_back(entry.cut);
+			}
+			else if (++entry.age > age_limit_)
+			{
+				has_old_cuts = true;
+			}
+		}
+	}
+	if (has_old_cuts) RemoveOldCuts();
+	return violated_cuts;
+}
+
+void CutPool::RemoveOldCuts()
+{
+	unique_lock<shared_timed_mutex> guard(lock_);
+	int kept_count = 0;
+	for (int i = 0; i < entries_.size(); ++i)
+	{
+		if (entries_[i].age > age_limit_) continue;
+		if (kept_count != i) entries_[kept_count] = move(entries_[i]);
+		++kept_count;
+	}
+	if (kept_count == entries_.size()) return; // another thread already removed them.
+	
+	// Rebuild the index, as positions changed.
+	entries_.erase(entries_.begin() + kept_count, entries_.end());
+	index_.clear();
+	for (int i = 0; i < entries_.size(); ++i) index_.insert({entries_[i].hash, i});
+}
+} // namespace goc
\ No newline at end of file
@@ -6,131 +6,352 @@
 
 #include "goc/linear_programming/cuts/separation_algorithm.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <set>
+#include <unordered_set>
 #include <climits>
 
 #include "goc/time/stopwatch.h"
 #include "goc/collection/collection_utils.h"
+#include "goc/exception/exception_utils.h"
 #include "goc/math/number_utils.h"
 
 using namespace std;
 
 namespace goc
 {
+namespace
+{
+// Reserves up to 'amount' units of the counter without exceeding 'limit'.
+// Returns: the number of units reserved (0 if the limit was already reached).
+int reserve(atomic<int>* counter, int amount, int limit)
+{
+	int current = counter->load();
+	while (true)
+	{
+		int granted = min(amount, limit - current);
+		if (granted <= 0) return 0;
+		if (counter->compare_exchange_weak(current, current + granted)) return granted;
+	}
+}
+
+// Adds value to the atomic target.
+void atomic_add(atomic<double>* target, double value)
+{
+	double current = target->load();
+	while (!target->compare_exchange_weak(current, current + value));
+}
+
+// Returns: the separation routines of all the families in the strategy.
+vector<const SeparationRoutine*> separation_routines(const SeparationStrategy& strategy)
+{
+	vector<const SeparationRoutine*> routines;
+	for (auto& family: strategy.Families()) routines.push_back(strategy.SeparationRoutineFor(family));
+	return routines;
+}
+
+// Returns: how much the solution violates the cut (negative if the cut holds with slack).
+template<typename ValuationType>
+double violation(const Constraint& cut, const ValuationType& solution)
+{
+	double lhs = cut.LeftSide().Value(solution);
+	switch (cut.Sense())
+	{
+		case Constraint::LessEqual: return lhs - cut.RightSide();
+		case Constraint::GreaterEqual: return cut.RightSide() - lhs;
+		default: return fabs(lhs - cut.RightSide());
+	}
+}
+
+// Returns: the euclidean norm of the left side of the cut.
+double norm(const Constraint& cut)
+{
+	double sum = 0.0;
+	for (double coefficient: cut.LeftSide().Coefficients()) sum += coefficient * coefficient;
+	return sqrt(sum);
+}
+
+// Returns: the dot product of the left sides of the cuts.
+// Observation: terms are sorted by variable, so it is a merge of both sequences.
+double dot(const Constraint& c1, const Constraint& c2)
+{
+	auto& v1 = c1.LeftSide().Variables();
+	auto& a1 = c1.LeftSide().Coefficients();
+	auto& v2 = c2.LeftSide().Variables();
+	auto& a2 = c2.LeftSide().Coefficients();
+	double sum = 0.0;
+	for (int i = 0, j = 0; i < v1.size() && j < v2.size();)
+	{
+		if (v1[i] < v2[j]) ++i;
+		else if (v2[j] < v1[i]) ++j;
+		else sum += a1[i++] * a2[j++];
+	}
+	return sum;
+}
+
+// Selects the cuts to add from the candidates, preferring the most efficacious ones (violation / norm) and skipping
+// the ones that are almost parallel to cuts already selected. Candidates with an empty left side or that are not
+// violated by more than epsilon (relative to their norm) are discarded.
+// candidates: cuts found by a separation routine.
+// selected: cuts selected so far in this iteration (the chosen candidates are appended to it).
+// selected_norms: norms of the selected cuts (selected_norms[i] is the norm of selected[i]).
+// max_parallelism: candidates with |cos| bigger than this value with respect to a selected cut are discarded.
+// limit: maximum number of candidates to select.
+// Returns: the number of candidates appended to selected.
+template<typename ValuationType>
+int select_cuts(const vector<Constraint>& candidates, const ValuationType& solution, double max_parallelism, int limit,
+	vector<Constraint>* selected, vector<double>* selected_norms)
+{
+	// Sort candidates by efficacy, the most violated with respect to their norm first.
+	vector<int> order;
+	vector<double> efficacy(candidates.size()), norms(candidates.size());
+	for (int i = 0; i < candidates.size(); ++i)
+	{
+		norms[i] = norm(candidates[i]);
+		if (epsilon_equal(norms[i], 0.0)) continue;
+		efficacy[i] = violation(candidates[i], solution) / norms[i];
+		if (epsilon_bigger(efficacy[i], 0.0)) order.push_back(i);
+	}
+	stable_sort(order.begin(), order.end(), [&] (int i, int j) { return efficacy[i] > efficacy[j]; });
+	
+	// Greedily keep the best candidates which are not too parallel to the ones already selected.
+	int first_candidate = selected->size();
+	for (int i: order)
+	{
+		if (selected->size() - first_candidate >= limit) break;
+		bool is_parallel = false;
+		for (int k = 0; k < selected->size() && !is_parallel && max_parallelism < 1.0; ++k)
+			is_parallel = fabs(dot(candidates[i], (*selected)[k])) / (norms[i] * (*selected_norms)[k]) > max_parallelism;
+		if (is_parallel) continue;
+		selected->push_back(candidates[i]);
+		selected_norms->push_back(norms[i]);
+	}
+	return (int)selected->size() - first_candidate;
+}
+}
+
 SeparationAlgorithm::SeparationAlgorithm(const SeparationStrategy& separation_strategy)
-	: strategy_(separation_strategy), is_disabled_(false)
+	: strategy_(separation_strategy), executor_(separation_routines(separation_strategy)), cuts_from_pool_(0), disabled_family_count_(0), is_disabled_(false)
 {
+	if (strategy_.thread_count > 1) thread_pool_.reset(new ThreadPool(strategy_.thread_count));
+	
 	// Calculate topological order of families.
 	families_ordered_by_dependencies_ = strategy_.Families();
 	sort(families_ordered_by_dependencies_.begin(), families_ordered_by_dependencies_.end(),
 		[&] (const string& f1, const string& f2) { return strategy_.HasDependency(f2, f1); });
 	
 	// Init tracking limit structure.
-	for (auto& family: families_ordered_by_dependencies_)
+	for (int i = 0; i < families_ordered_by_dependencies_.size(); ++i)
 	{
-		cuts_added_[family] = iteration_count_[family] = 0;
-		separation_time_[family] = 0.0_sec;
+		const string& family = families_ordered_by_dependencies_[i];
+		family_index_[family] = i;
+		family_states_.emplace_back(new FamilyState());
+		family_states_[i]->cuts_added = family_states_[i]->iteration_count = 0;
+		family_states_[i]->separation_time = 0.0;
+		family_states_[i]->disabled = false;
+		if (strategy_.cut_pool_age_limit > 0) cut_pools_.emplace_back(new CutPool(strategy_.cut_pool_age_limit));
 	}
 	last_objective_ = INFTY;
+	
+	// Group families by dependency level (the length of the longest dependency chain starting at the family).
+	vector<int> level(families_ordered_by_dependencies_.size(), 0);
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (int i = 0; i < families_ordered_by_dependencies_.size(); ++i)
+		{
+			for (auto& dependency: strategy_.Dependencies(families_ordered_by_dependencies_[i]))
+			{
+				if (!includes_key(family_index_, dependency) || level[i] > level[family_index_[dependency]]) continue;
+				level[i] = level[family_index_[dependency]] + 1;
+				if (level[i] >= families_ordered_by_dependencies_.size()) fail("Cut family dependencies have a cycle.");
+				changed = true;
+			}
+		}
+	}
+	for (int i = 0; i < families_ordered_by_dependencies_.size(); ++i)
+	{
+		if (dependency_levels_.size() <= level[i]) dependency_levels_.resize(level[i] + 1);
+		dependency_levels_[level[i]].push_back(i);
+	}
 }
 
 vector<Constraint> SeparationAlgorithm::Separate(const Valuation& solution, int node_number, double node_bound) const
+{
+	return SeparateSolution(solution, node_number, node_bound);
+}
+
+vector<Constraint> SeparationAlgorithm::Separate(const ValuationView& solution, int node_number, double node_bound) const
+{
+	return SeparateSolution(solution, node_number, node_bound);
+}
+
+template<typename ValuationType>
+vector<Constraint> SeparationAlgorithm::SeparateSolution(const ValuationType& solution, int node_number,
+	double node_bound) const
 {
 	vector<Constraint> cuts;
-	if (is_disabled_) return cuts;
-	if (disabled_families_.size() == strategy_.Families().size()) return cuts;
+	if (!IsEnabled()) return cuts;
+	
+	vector<double> cut_norms; // cut_norms[i] is the norm of cuts[i], used to measure parallelism.
+	
+	// Returns: if the family f is disabled, disabling it if it reached its node, cut or iteration limit.
+	auto is_disabled = [&] (int f) {
+		const string& family = families_ordered_by_dependencies_[f];
+		FamilyState& state = *family_states_[f];
+		if (state.disabled) return true;
+		if (strategy_.node_limit.at(family) <= node_number || strategy_.cut_limit.at(family) <= state.cuts_added ||
+			strategy_.iteration_limit.at(family) <= state.iteration_count)
+		{
+			DisableFamily(f);
+			return true;
+		}
+		return false;
+	};
 	
-	// Adquire lock.
-	lock_.lock();
+	// Cuts from the pool violated by the solution are added before trying the separation routines. They are selected
+	// like the cuts of their family, but they do not count for its cut limit (they were counted when found). Pools of
+	// disabled families are not used.
+	if (!cut_pools_.empty())
+	{
+		for (int f = 0; f < cut_pools_.size(); ++f)
+		{
+			if (is_disabled(f)) continue;
+			const string& family = families_ordered_by_dependencies_[f];
+			int limit = strategy_.cuts_per_iteration.at(family);
+			select_cuts(cut_pools_[f]->Separate(solution, limit), solution, strategy_.max_parallelism.at(family), limit,
+				&cuts, &cut_norms);
+		}
+		cuts_from_pool_ += cuts.size();
+		if (!cuts.empty()) return cuts;
+	}
 	
 	// Keep track of cut families that found violated cuts for dependencies purposes.
 	unordered_set<string> families_with_cuts;
 	
-	// Try to find violated cuts for all families.
-	for (auto& family: families_ordered_by_dependencies_)
+	// Families in the same level do not depend on each other, so they are separated at the same time. Each level is a
+	// barrier, its families are only separated once the families they depend on finished.
+	vector<vector<Constraint>> family_cuts(families_ordered_by_dependencies_.size());
+	vector<int> cut_limits(families_ordered_by_dependencies_.size());
+	for (auto& level: dependency_levels_)
 	{
-		if (includes(disabled_families_, family)) continue;
-		
-		// Check if family should be disabled.
-		if (strategy_.node_limit.at(family) <= node_number) disabled_families_.insert(family);
-		else if (strategy_.cut_limit.at(family) <= cuts_added_[family]) disabled_families_.insert(family);
-		else if (strategy_.iteration_limit.at(family) <= iteration_count_.at(family)) disabled_families_.insert(family);
-		
-		if (includes(disabled_families_, family)) continue;
-		
-		// Check if all the dependecies of the family of inequalities have failed to find cuts. If so, then we proceed
-		// to find cuts.
-		bool all_dependencies_failed = true;
-		for (auto& dependency: strategy_.Dependencies(family))
+		vector<function<void()>> tasks;
+		for (int f: level)
 		{
-			if (includes(families_with_cuts, dependency))
+			const string& family = families_ordered_by_dependencies_[f];
+			FamilyState& state = *family_states_[f];
+			if (is_disabled(f)) continue;
+			
+			// Check if all the dependecies of the family of inequalities have failed to find cuts. If so, then we
+			// proceed to find cuts.
+			bool all_dependencies_failed = true;
+			for (auto& dependency: strategy_.Dependencies(family))
 			{
-				all_dependencies_failed = false;
-				break;
+				if (includes(families_with_cuts, dependency))
+				{
+					all_dependencies_failed = false;
+					break;
+				}
 			}
+			if (!all_dependencies_failed) continue;
+			
+			// Check what is the max amount of cuts that can be added in this iteration.
+			cut_limits[f] = CutLimitForThisIteration(f, node_bound);
+			if (cut_limits[f] == 0) continue;
+			
+			// Reserve the iteration, other threads might be separating this family at the same time.
+			if (reserve(&state.iteration_count, 1, strategy_.iteration_limit.at(family)) == 0)
+			{
+				DisableFamily(f);
+				continue;
+			}
+			
+			// Execute the separation routine.
+			tasks.push_back([&, f] ()
+			{
+				const SeparationRoutine* routine = strategy_.SeparationRoutineFor(families_ordered_by_dependencies_[f]);
+				Stopwatch rolex(true);
+				family_cuts[f] = executor_.Separate(routine, solution, node_number, cut_limits[f], node_bound);
+				rolex.Pause();
+				atomic_add(&family_states_[f]->separation_time, rolex.Peek().Amount(DurationUnit::Milliseconds));
+			});
 		}
-		if (!all_dependencies_failed) continue;
+		if (thread_pool_) thread_pool_->Run(tasks);
+		else for (auto& task: tasks) task();
 		
-		// Check what is the max amount of cuts that can be added in this iteration.
-		int cut_limit = CutLimitForThisIteration(family, node_bound);
-		if (cut_limit == 0) continue;
-		
-		// Execute the separation routine.
-		Stopwatch rolex(true);
-		vector<Constraint> family_cuts = strategy_.SeparationRoutineFor(family)->Separate(solution, node_number, cut_limit, node_bound);
-		rolex.Pause();
-		for (int i = 0; i < min((int)family_cuts.size(), cut_limit); ++i) cuts.push_back(family_cuts[i]);
-		if (!family_cuts.empty()) families_with_cuts.insert(family);
-		
-		// Keep track of statistics.
-		cuts_added_[family] += min((int)family_cuts.size(), cut_limit);
-		iteration_count_[family]++;
-		separation_time_[family] += rolex.Peek();
+		// Families are processed in order after the barrier, so the cuts selected do not depend on thread timing.
+		for (int f: level)
+		{
+			if (family_cuts[f].empty()) continue;
+			const string& family = families_ordered_by_dependencies_[f];
+			
+			// Select the best cuts, and reserve them so the family cut limit holds even if other threads added cuts
+			// meanwhile. Selected cuts that could not be reserved are dropped.
+			int first_cut = cuts.size();
+			int selected_count = select_cuts(family_cuts[f], solution, strategy_.max_parallelism.at(family),
+				cut_limits[f], &cuts, &cut_norms);
+			int cuts_to_add = reserve(&family_states_[f]->cuts_added, selected_count, strategy_.cut_limit.at(family));
+			cuts.erase(cuts.begin() + first_cut + cuts_to_add, cuts.end());
+			cut_norms.erase(cut_norms.begin() + first_cut + cuts_to_add, cut_norms.end());
+			if (!cut_pools_.empty()) for (int i = first_cut; i < cuts.size(); ++i) cut_pools_[f]->Add(cuts[i]);
+			if (cuts_to_add > 0) families_with_cuts.insert(family);
+		}
 	}
 	last_objective_ = node_bound;
-	lock_.unlock();
 	return cuts;
 }
 
 bool SeparationAlgorithm::IsEnabled() const
 {
-	return !is_disabled_ && disabled_families_.size() < strategy_.Families().size();
+	return !is_disabled_ && disabled_family_count_ < strategy_.Families().size();
 }
 
 int SeparationAlgorithm::CutsAdded() const
 {
 	int count = 0;
-	for (auto& it: cuts_added_) count += it.second;
+	for (auto& state: family_states_) count += state->cuts_added;
 	return count;
 }
 
 int SeparationAlgorithm::CutsAdded(const string& family) const
 {
-	return cuts_added_.at(family);
+	return family_states_[family_index_.at(family)]->cuts_added;
+}
+
+bool SeparationAlgorithm::UsesCutPool() const
+{
+	return !cut_pools_.empty();
+}
+
+int SeparationAlgorithm::CutsFromPool() const
+{
+	return cuts_from_pool_;
 }
 
 int SeparationAlgorithm::IterationCount() const
 {
 	int count = 0;
-	for (auto& it: iteration_count_) count += it.second;
+	for (auto& state: family_states_) count += state->iteration_count;
 	return count;
 }
 
 int SeparationAlgorithm::IterationCount(const string& family) const
 {
-	return iteration_count_.at(family);
+	return family_states_[family_index_.at(family)]->iteration_count;
 }
 
 Duration SeparationAlgorithm::SeparationTime() const
 {
-	Duration count;
-	for (auto& it: separation_time_) count += it.second;
-	return count;
+	double count = 0.0;
+	for (auto& state: family_states_) count += state->separation_time;
+	return Duration(count, DurationUnit::Milliseconds);
 }
 
 Duration SeparationAlgorithm::SeparationTime(const string& family) const
 {
-	return separation_time_.at(family);
+	return Duration(family_states_[family_index_.at(family)]->separation_time, DurationUnit::Milliseconds);
 }
 
 const SeparationStrategy& SeparationAlgorithm::Strategy() const
@@ -143,13 +364,19 @@ void SeparationAlgorithm::Disable() const
 	is_disabled_ = true;
 }
 
-int SeparationAlgorithm::CutLimitForThisIteration(const string& family, double node_bound) const
+int SeparationAlgorithm::CutLimitForThisIteration(int family_index, double node_bound) const
 {
+	const string& family = families_ordered_by_dependencies_[family_index];
 	int limit = INT_MAX;
-	limit = min(limit, strategy_.cut_limit.at(family) - cuts_added_.at(family));
+	limit = min(limit, strategy_.cut_limit.at(family) - family_states_[family_index]->cuts_added);
 	limit = min(limit, strategy_.iteration_limit.at(family));
 	limit = min(limit, strategy_.cuts_per_iteration.at(family));
 	if (fabs(node_bound-last_objective_) < strategy_.improvement.at(family)) limit = 0;
 	return max(limit, 0);
 }
-} // namespace goc
\ No newline at end of file
+
+void SeparationAlgorithm::DisableFamily(int family_index) const
+{
+	if (!family_states_[family_index]->disabled.exchange(true)) ++disabled_family_count_;
+}
+} // namespace goc
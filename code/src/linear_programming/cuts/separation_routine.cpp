@@ -0,0 +1,38 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/cuts/separation_routine.h"
+
+#include "goc/exception/exception_utils.h"
+
+using namespace std;
+
+namespace goc
+{
+SeparationRoutine::Concurrency SeparationRoutine::ConcurrencySupport() const
+{
+	return Concurrency::Serialized;
+}
+
+SeparationRoutine* SeparationRoutine::Clone() const
+{
+	fail("Cloneable separation routines must override Clone.");
+	return nullptr;
+}
+
+vector<Constraint> SeparationRoutine::Separate(const Valuation& solution, int node_number, int count_limit,
+	double node_bound) const
+{
+	fail("SeparationRoutine must override at least one of the Separate methods.");
+	return {};
+}
+
+vector<Constraint> SeparationRoutine::Separate(const ValuationView& solution, int node_number, int count_limit,
+	double node_bound) const
+{
+	return Separate(solution.ToValuation(), node_number, count_limit, node_bound);
+}
+} // namespace goc
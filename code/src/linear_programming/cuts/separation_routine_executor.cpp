@@ -0,0 +1,61 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/cuts/separation_routine_executor.h"
+
+#include "goc/collection/collection_utils.h"
+
+using namespace std;
+
+namespace goc
+{
+SeparationRoutineExecutor::SeparationRoutineExecutor(const vector<const SeparationRoutine*>& routines)
+{
+	for (const SeparationRoutine* routine: routines)
+		if (routine->ConcurrencySupport() == SeparationRoutine::Concurrency::Serialized &&
+			!includes_key(routine_locks_, routine))
+			routine_locks_[routine] = unique_ptr<mutex>(new mutex());
+}
+
+vector<Constraint> SeparationRoutineExecutor::Separate(const SeparationRoutine* routine, const Valuation& solution,
+	int node_number, int count_limit, double node_bound) const
+{
+	return SeparateSolution(routine, solution, node_number, count_limit, node_bound);
+}
+
+vector<Constraint> SeparationRoutineExecutor::Separate(const SeparationRoutine* routine, const ValuationView& solution,
+	int node_number, int count_limit, double node_bound) const
+{
+	return SeparateSolution(routine, solution, node_number, count_limit, node_bound);
+}
+
+template<typename ValuationType>
+vector<Constraint> SeparationRoutineExecutor::SeparateSolution(const SeparationRoutine* routine,
+	const ValuationType& solution, int node_number, int count_limit, double node_bound) const
+{
+	switch (routine->ConcurrencySupport())
+	{
+		case SeparationRoutine::Concurrency::Cloneable:
+			return CloneFor(routine)->Separate(solution, node_number, count_limit, node_bound);
+		case SeparationRoutine::Concurrency::Serialized:
+		{
+			lock_guard<mutex> guard(*routine_locks_.at(routine));
+			return routine->Separate(solution, node_number, count_limit, node_bound);
+		}
+		default:
+			return routine->Separate(solution, node_number, count_limit, node_bound);
+	}
+}
+
+const SeparationRoutine* SeparationRoutineExecutor::CloneFor(const SeparationRoutine* routine) const
+{
+	// Only the lookup is guarded, each thread uses its clone without holding the lock.
+	lock_guard<mutex> guard(clones_lock_);
+	auto& clone = clones_[this_thread::get_id()][routine];
+	if (!clone) clone.reset(routine->Clone());
+	return clone.get();
+}
+} // namespace goc
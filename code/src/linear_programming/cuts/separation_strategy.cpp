@@ -22,6 +22,8 @@ namespace goc
 
 SeparationStrategy::SeparationStrategy()
 {
+	cut_pool_age_limit = 0;
+	thread_count = 1;
 }
 
 void SeparationStrategy::AddFamily(const string& family)
@@ -33,6 +35,7 @@ void SeparationStrategy::AddFamily(const string& family)
 	cuts_per_iteration[family] = INT_MAX;
 	node_limit[family] = INT_MAX;
 	improvement[family] = 0.0;
+	max_parallelism[family] = 1.0;
 }
 
 void SeparationStrategy::SetSeparationRoutine(const string& family, const SeparationRoutine* routine)
@@ -129,6 +132,18 @@ void to_json(json& j, const SeparationStrategy& s)
 		improvement_str += family + ":" + STR(s.improvement.at(family));
 	}
 	if (!improvement_str.empty()) j["improvement"] = improvement_str;
+	
+	string max_parallelism_str = "";
+	for (auto& family: s.Families())
+	{
+		if (s.max_parallelism.at(family) == 1.0) continue;
+		if (max_parallelism_str != "") max_parallelism_str += ",";
+		max_parallelism_str += family + ":" + STR(s.max_parallelism.at(family));
+	}
+	if (!max_parallelism_str.empty()) j["max_parallelism"] = max_parallelism_str;
+	
+	if (s.cut_pool_age_limit > 0) j["cut_pool_age_limit"] = s.cut_pool_age_limit;
+	if (s.thread_count > 1) j["thread_count"] = s.thread_count;
 }
 
 void from_json(const json& j, SeparationStrategy& s)
@@ -245,6 +260,37 @@ void from_json(const json& j, SeparationStrategy& s)
 		}
 	}
 	
+	// Parse max_parallelism.
+	// Example: {"max_parallelism": "f1:0.9, f2: 0.99"}.
+	// Example: {"max_parallelism": "*:0.9"} <- * means all cuts.
+	if (has_key(j, "max_parallelism") && j["max_parallelism"] != "")
+	{
+		auto limits = split(j["max_parallelism"], ',');
+		for (auto& limit: limits)
+		{
+			auto split_limit = split(limit, ':');
+			string f = trim(split_limit[0]);
+			double l = atof(trim(split_limit[1]).c_str());
+			if (f == "*")
+			{
+				for (auto& family: s.Families())
+					s.max_parallelism[family] = l;
+			}
+			else
+			{
+				s.max_parallelism[f] = l;
+			}
+		}
+	}
+	
+	// Parse cut_pool_age_limit.
+	// Example: {"cut_pool_age_limit": 50}.
+	if (has_key(j, "cut_pool_age_limit")) s.cut_pool_age_limit = j["cut_pool_age_limit"];
+	
+	// Parse thread_count.
+	// Example: {"thread_count": 4}.
+	if (has_key(j, "thread_count")) s.thread_count = j["thread_count"];
+	
 	// Parse dependencies.
 	// Example: {"dependencies": "f1<f2, f3 < f4"}.
 	if (has_key(j, "dependencies") && j["dependencies"] != "")
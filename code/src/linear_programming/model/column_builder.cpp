@@ -0,0 +1,163 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/model/column_builder.h"
+
+using namespace std;
+
+namespace goc
+{
+ColumnBuilder::ColumnBuilder() : open_column_begin_(0)
+{ }
+
+void ColumnBuilder::Reserve(int column_count, int nonzero_count)
+{
+	column_begin_.reserve(column_count);
+	names_.reserve(column_count);
+	objective_coefficients_.reserve(column_count);
+	domains_.reserve(column_count);
+	lower_bounds_.reserve(column_count);
+	upper_bounds_.reserve(column_count);
+	row_indices_.reserve(nonzero_count);
+	values_.reserve(nonzero_count);
+}
+
+ColumnBuilder& ColumnBuilder::AddTerm(int constraint_index, double coefficient)
+{
+	row_indices_.push_back(constraint_index);
+	values_.push_back(coefficient);
+	return *this;
+}
+
+ColumnBuilder& ColumnBuilder::EndColumn(const string& name, double objective_coefficient, VariableDomain domain,
+	double lower_bound, double upper_bound)
+{
+	column_begin_.push_back(open_column_begin_);
+	open_column_begin_ = values_.size();
+	names_.push_back(name);
+	objective_coefficients_.push_back(objective_coefficient);
+	domains_.push_back(domain);
+	lower_bounds_.push_back(lower_bound);
+	upper_bounds_.push_back(upper_bound);
+	return *this;
+}
+
+ColumnBuilder& ColumnBuilder::AddColumns(const ColumnBuilder& columns)
+{
+	int offset = open_column_begin_;
+	for (int begin: columns.column_begin_) column_begin_.push_back(offset + begin);
+	row_indices_.insert(row_indices_.end(), columns.row_indices_.begin(),
+		columns.row_indices_.begin() + columns.NonZeroCount());
+	values_.insert(values_.end(), columns.values_.begin(), columns.values_.begin() + columns.NonZeroCount());
+	names_.insert(names_.end(), columns.names_.begin(), columns.names_.end());
+	objective_coefficients_.insert(objective_coefficients_.end(), columns.objective_coefficients_.begin(),
+		columns.objective_coefficients_.end());
+	domains_.insert(domains_.end(), columns.domains_.begin(), columns.domains_.end());
+	lower_bounds_.insert(lower_bounds_.end(), columns.lower_bounds_.begin(), columns.lower_bounds_.end());
+	upper_bounds_.insert(upper_bounds_.end(), columns.upper_bounds_.begin(), columns.upper_bounds_.end());
+	open_column_begin_ = values_.size();
+	return *this;
+}
+
+void ColumnBuilder::RemoveColumns(const vector<bool>& is_removed)
+{
+	int column_count = ColumnCount(), kept_count = 0, nonzero_count = 0;
+	for (int j = 0; j < column_count; ++j)
+	{
+		int begin = column_begin_[j], end = j + 1 < column_count ? column_begin_[j + 1] : open_column_begin_;
+		if (is_removed[j]) continue;
+		
+		// Move the column j to position kept_count (which is not after j, so no column kept is overwritten).
+		column_begin_[kept_count] = nonzero_count;
+		for (int k = begin; k < end; ++k, ++nonzero_count)
+		{
+			row_indices_[nonzero_count] = row_indices_[k];
+			values_[nonzero_count] = values_[k];
+		}
+		if (kept_count != j)
+		{
+			names_[kept_count] = move(names_[j]);
+			objective_coefficients_[kept_count] = objective_coefficients_[j];
+			domains_[kept_count] = domains_[j];
+			lower_bounds_[kept_count] = lower_bounds_[j];
+			upper_bounds_[kept_count] = upper_bounds_[j];
+		}
+		++kept_count;
+	}
+	column_begin_.resize(kept_count);
+	names_.resize(kept_count);
+	objective_coefficients_.resize(kept_count);
+	domains_.resize(kept_count);
+	lower_bounds_.resize(kept_count);
+	upper_bounds_.resize(kept_count);
+	row_indices_.resize(nonzero_count);
+	values_.resize(nonzero_count);
+	open_column_begin_ = nonzero_count;
+}
+
+void ColumnBuilder::Clear()
+{
+	column_begin_.clear();
+	row_indices_.clear();
+	values_.clear();
+	names_.clear();
+	objective_coefficients_.clear();
+	domains_.clear();
+	lower_bounds_.clear();
+	upper_bounds_.clear();
+	open_column_begin_ = 0;
+}
+
+int ColumnBuilder::ColumnCount() const
+{
+	return names_.size();
+}
+
+int ColumnBuilder::NonZeroCount() const
+{
+	return open_column_begin_;
+}
+
+const vector<int>& ColumnBuilder::ColumnBegin() const
+{
+	return column_begin_;
+}
+
+const vector<int>& ColumnBuilder::RowIndices() const
+{
+	return row_indices_;
+}
+
+const vector<double>& ColumnBuilder::Values() const
+{
+	return values_;
+}
+
+const vector<string>& ColumnBuilder::Names() const
+{
+	return names_;
+}
+
+const vector<double>& ColumnBuilder::ObjectiveCoefficients() const
+{
+	return objective_coefficients_;
+}
+
+const vector<VariableDomain>& ColumnBuilder::Domains() const
+{
+	return domains_;
+}
+
+const vector<double>& ColumnBuilder::LowerBounds() const
+{
+	return lower_bounds_;
+}
+
+const vector<double>& ColumnBuilder::UpperBounds() const
+{
+	return upper_bounds_;
+}
+} // namespace goc
@@ -30,7 +30,16 @@ enum Constraint::Sense Constraint::Sense() const
 
 bool Constraint::Holds(const Valuation& v) const
 {
-	double left_value = left_side_.Value(v);
+	return HoldsFor(left_side_.Value(v));
+}
+
+bool Constraint::Holds(const ValuationView& v) const
+{
+	return HoldsFor(left_side_.Value(v));
+}
+
+bool Constraint::HoldsFor(double left_value) const
+{
 	double right_value = right_side_;
 	switch (Sense())
 	{
@@ -59,6 +68,7 @@ Constraint::Constraint(const Expression& left, const Expression& right, enum Sen
 	left_side_ = left - right;
 	right_side_ = -left_side_.Scalar();
 	left_side_.SetScalar(0.0);
+	left_side_.Normalize();
 	sense_ = sense;
 }
 } // namespace goc
\ No newline at end of file
@@ -0,0 +1,162 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/model/dense_valuation.h"
+
+#include <cmath>
+
+#include "goc/exception/exception_utils.h"
+#include "goc/linear_programming/model/formulation.h"
+#include "goc/math/number_utils.h"
+
+using namespace std;
+
+namespace goc
+{
+ValuationView::ValuationView() : values_(nullptr), size_(0), formulation_(nullptr), support_(nullptr)
+{ }
+
+ValuationView::ValuationView(const double* values, int size, const Formulation* formulation,
+	const vector<int>* support)
+	: values_(values), size_(size), formulation_(formulation), support_(support)
+{ }
+
+double ValuationView::operator[](const Variable& v) const
+{
+	return (*this)[v.Index()];
+}
+
+double ValuationView::operator[](int variable_index) const
+{
+	return variable_index < size_ ? values_[variable_index] : 0.0;
+}
+
+double ValuationView::at(const Variable& v) const
+{
+	return (*this)[v.Index()];
+}
+
+int ValuationView::Size() const
+{
+	return size_;
+}
+
+const double* ValuationView::Data() const
+{
+	return values_;
+}
+
+const Formulation* ValuationView::Model() const
+{
+	return formulation_;
+}
+
+bool ValuationView::HasSupport() const
+{
+	return support_ != nullptr;
+}
+
+const vector<int>& ValuationView::Support() const
+{
+	if (!support_) fail("ValuationView::Support requires a view created with its support.");
+	return *support_;
+}
+
+bool ValuationView::IsInteger() const
+{
+	if (support_)
+	{
+		for (int i: *support_)
+			if (epsilon_different(values_[i], round(values_[i])))
+				return false;
+		return true;
+	}
+	
+	for (int i = 0; i < size_; ++i)
+		if (epsilon_different(values_[i], round(values_[i])))
+			return false;
+	
+	return true;
+}
+
+Valuation ValuationView::ToValuation() const
+{
+	if (!formulation_) fail("ValuationView::ToValuation requires the formulation of the variables.");
+	Valuation valuation;
+	if (support_)
+	{
+		for (int i: *support_)
+			if (epsilon_different(values_[i], 0.0))
+				valuation.SetValue(formulation_->VariableAtIndex(i), values_[i]);
+		return valuation;
+	}
+	
+	for (int i = 0; i < size_; ++i)
+		if (epsilon_different(values_[i], 0.0))
+			valuation.SetValue(formulation_->VariableAtIndex(i), values_[i]);
+	return valuation;
+}
+
+void build_support(const double* values, int size, vector<int>* support)
+{
+	support->clear();
+	for (int i = 0; i < size; ++i)
+		if (epsilon_different(values[i], 0.0))
+			support->push_back(i);
+}
+
+DenseValuation::DenseValuation() : formulation_(nullptr)
+{ }
+
+DenseValuation::DenseValuation(int size, const Formulation* formulation)
+	: values_(size, 0.0), formulation_(formulation)
+{ }
+
+DenseValuation::DenseValuation(vector<double> values, const Formulation* formulation)
+	: values_(move(values)), formulation_(formulation)
+{ }
+
+void DenseValuation::SetValue(const Variable& v, double value)
+{
+	if (v.Index() >= values_.size()) values_.resize(v.Index()+1, 0.0);
+	values_[v.Index()] = value;
+}
+
+double DenseValuation::operator[](const Variable& v) const
+{
+	return v.Index() < values_.size() ? values_[v.Index()] : 0.0;
+}
+
+double DenseValuation::at(const Variable& v) const
+{
+	return (*this)[v];
+}
+
+int DenseValuation::Size() const
+{
+	return values_.size();
+}
+
+double* DenseValuation::Data()
+{
+	return values_.data();
+}
+
+ValuationView DenseValuation::View() const
+{
+	return ValuationView(values_.data(), values_.size(), formulation_);
+}
+
+DenseValuation::operator ValuationView() const
+{
+	return View();
+}
+
+Valuation DenseValuation::ToValuation() const
+{
+	return View().ToValuation();
+}
+} // namespace goc
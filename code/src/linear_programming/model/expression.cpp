@@ -21,34 +21,28 @@ namespace goc
 Expression::Expression() : Expression(0.0)
 { }
 
-Expression::Expression(double scalar) : scalar_(scalar)
+Expression::Expression(double scalar) : normalized_count_(0), scalar_(scalar)
 { }
 
 Expression::Expression(const Variable& v) : Expression()
 {
-	SetVariableCoefficient(v, 1.0);
+	AppendTerm(v, 1.0);
 }
 
 void Expression::operator+=(const Expression& e)
 {
+	if (&e == this) { *this *= 2.0; return; }
 	scalar_ += e.scalar_;
-	for (auto& variable_coefficient: e.coefficients_)
-	{
-		double new_coefficient = VariableCoefficient(variable_coefficient.first)+variable_coefficient.second;
-		if (epsilon_equal(new_coefficient, 0.0)) coefficients_.erase(variable_coefficient.first);
-		else coefficients_[variable_coefficient.first] = new_coefficient;
-	}
+	variables_.insert(variables_.end(), e.variables_.begin(), e.variables_.end());
+	coefficients_.insert(coefficients_.end(), e.coefficients_.begin(), e.coefficients_.end());
 }
 
 void Expression::operator-=(const Expression& e)
 {
+	if (&e == this) { *this *= 0.0; return; }
 	scalar_ -= e.scalar_;
-	for (auto& variable_coefficient: e.coefficients_)
-	{
-		double new_coefficient = VariableCoefficient(variable_coefficient.first)-variable_coefficient.second;
-		if (epsilon_equal(new_coefficient, 0.0)) coefficients_.erase(variable_coefficient.first);
-		else coefficients_[variable_coefficient.first] = new_coefficient;
-	}
+	variables_.insert(variables_.end(), e.variables_.begin(), e.variables_.end());
+	for (double coefficient: e.coefficients_) coefficients_.push_back(-coefficient);
 }
 
 void Expression::operator-=(double scalar)
@@ -64,25 +58,31 @@ void Expression::operator+=(double scalar)
 void Expression::operator*=(double scalar)
 {
 	scalar_ *= scalar;
-	if (epsilon_equal(scalar, 0.0)) { coefficients_.clear(); return; }
-	for (auto& variable_coefficient: coefficients_) variable_coefficient.second *= scalar;
+	if (epsilon_equal(scalar, 0.0))
+	{
+		variables_.clear();
+		coefficients_.clear();
+		normalized_count_ = 0;
+		return;
+	}
+	for (double& coefficient: coefficients_) coefficient *= scalar;
 }
 
 void Expression::operator/=(double scalar)
 {
 	if (epsilon_equal(scalar, 0.0)) fail("Expression: Division by 0.");
 	scalar_ /= scalar;
-	for (auto& variable_coefficient: coefficients_) variable_coefficient.second /= scalar;
+	for (double& coefficient: coefficients_) coefficient /= scalar;
 }
 
 void Expression::operator+=(const Variable& v)
 {
-	*this += 1.0*v;
+	AppendTerm(v, 1.0);
 }
 
 void Expression::operator-=(const Variable& v)
 {
-	*this -= 1.0*v;
+	AppendTerm(v, -1.0);
 }
 
 Expression Expression::operator+(const Expression& e) const
@@ -144,8 +144,25 @@ Constraint Expression::EQ(const Expression& e) const
 
 void Expression::SetVariableCoefficient(const Variable& variable, double coefficient)
 {
-	if (epsilon_equal(coefficient, 0.0)) coefficients_.erase(variable);
-	else coefficients_[variable] = coefficient;
+	Normalize();
+	int i = lower_bound(variables_.begin(), variables_.end(), variable) - variables_.begin();
+	bool is_present = i < variables_.size() && variables_[i] == variable;
+	if (epsilon_equal(coefficient, 0.0))
+	{
+		if (!is_present) return;
+		variables_.erase(variables_.begin() + i);
+		coefficients_.erase(coefficients_.begin() + i);
+	}
+	else if (is_present)
+	{
+		coefficients_[i] = coefficient;
+	}
+	else
+	{
+		variables_.insert(variables_.begin() + i, variable);
+		coefficients_.insert(coefficients_.begin() + i, coefficient);
+	}
+	normalized_count_ = variables_.size();
 }
 
 // Sets the scalar value to scalar.
@@ -158,7 +175,10 @@ void Expression::SetScalar(double scalar)
 // Observation: if the variable is not present a coefficient of 0 is returned.
 double Expression::VariableCoefficient(const Variable& variable) const
 {
-	return includes_key(coefficients_, variable) ? coefficients_.at(variable) : 0.0;
+	Normalize();
+	auto it = lower_bound(variables_.begin(), variables_.end(), variable);
+	if (it == variables_.end() || *it != variable) return 0.0;
+	return coefficients_[it - variables_.begin()];
 }
 
 // Returns: the scalar value.
@@ -169,42 +189,126 @@ double Expression::Scalar() const
 
 int Expression::NonZeroVariableTermCount() const
 {
-	return coefficients_.size();
+	Normalize();
+	return variables_.size();
 }
 
 vector<pair<Variable, double>> Expression::Terms() const
 {
+	Normalize();
 	vector<pair<Variable, double>> terms;
-	for (auto& variable_coefficient: coefficients_) terms.push_back(variable_coefficient);
+	terms.reserve(variables_.size());
+	for (int i = 0; i < variables_.size(); ++i) terms.push_back({variables_[i], coefficients_[i]});
 	return terms;
 }
 
+const vector<Variable>& Expression::Variables() const
+{
+	Normalize();
+	return variables_;
+}
+
+const vector<double>& Expression::Coefficients() const
+{
+	Normalize();
+	return coefficients_;
+}
+
 // Returns: the expression evaluated on the valuation v.
 double Expression::Value(const Valuation& v) const
+{
+	// Terms are linear, so there is no need to normalize them before evaluating.
+	double value = scalar_;
+	for (int i = 0; i < variables_.size(); ++i) value += v[variables_[i]] * coefficients_[i];
+	return value;
+}
+
+double Expression::Value(const ValuationView& v) const
 {
 	double value = scalar_;
-	for (auto& variable_coefficient: coefficients_) value += v[variable_coefficient.first] * variable_coefficient.second;
+	for (int i = 0; i < variables_.size(); ++i) value += v[variables_[i].Index()] * coefficients_[i];
 	return value;
 }
 
 void Expression::Print(ostream& os) const
 {
-	if (coefficients_.empty()) { os << scalar_; return; }
-	bool is_first = true;
-	for (auto& variable_coefficient: coefficients_)
+	Normalize();
+	if (variables_.empty()) { os << scalar_; return; }
+	for (int i = 0; i < variables_.size(); ++i)
 	{
-		if (!is_first) os << " + ";
-		is_first = false;
-		if (epsilon_equal(variable_coefficient.second, 1.0)) os << variable_coefficient.first;
-		else os << variable_coefficient.second << " " << variable_coefficient.first;
+		if (i > 0) os << " + ";
+		if (epsilon_equal(coefficients_[i], 1.0)) os << variables_[i];
+		else os << coefficients_[i] << " " << variables_[i];
 	}
 	if (epsilon_different(scalar_, 0.0)) os << " + " << scalar_;
 }
 
+void Expression::Normalize() const
+{
+	int term_count = variables_.size();
+	if (normalized_count_ == term_count) return;
+	
+	// Sort the appended terms by variable (stable so repeated variables add up in the order they were added).
+	// Most of the times terms are appended in order (e.g. ESUM over variables), so we avoid sorting if possible.
+	vector<pair<Variable, double>> appended;
+	appended.reserve(term_count - normalized_count_);
+	for (int i = normalized_count_; i < term_count; ++i) appended.push_back({variables_[i], coefficients_[i]});
+	auto by_variable = [] (const pair<Variable, double>& t1, const pair<Variable, double>& t2) { return t1.first < t2.first; };
+	if (!is_sorted(appended.begin(), appended.end(), by_variable))
+		stable_sort(appended.begin(), appended.end(), by_variable);
+	
+	// Merge the normalized terms with the appended ones adding up the coefficients of repeated variables.
+	vector<Variable> variables;
+	vector<double> coefficients;
+	variables.reserve(term_count);
+	coefficients.reserve(term_count);
+	auto add_term = [&] (const Variable& variable, double coefficient)
+	{
+		if (!variables.empty() && variables.back() == variable) coefficients.back() += coefficient;
+		else { variables.push_back(variable); coefficients.push_back(coefficient); }
+	};
+	int i = 0, j = 0;
+	while (i < normalized_count_ || j < appended.size())
+	{
+		if (j == appended.size() || (i < normalized_count_ && !(appended[j].first < variables_[i])))
+		{
+			add_term(variables_[i], coefficients_[i]);
+			++i;
+		}
+		else
+		{
+			add_term(appended[j].first, appended[j].second);
+			++j;
+		}
+	}
+	
+	// Remove the terms that were cancelled.
+	int k = 0;
+	for (int l = 0; l < variables.size(); ++l)
+	{
+		if (epsilon_equal(coefficients[l], 0.0)) continue;
+		variables[k] = variables[l];
+		coefficients[k] = coefficients[l];
+		++k;
+	}
+	variables.resize(k);
+	coefficients.resize(k);
+	
+	variables_.swap(variables);
+	coefficients_.swap(coefficients);
+	normalized_count_ = k;
+}
+
+void Expression::AppendTerm(const Variable& variable, double coefficient)
+{
+	variables_.push_back(variable);
+	coefficients_.push_back(coefficient);
+}
+
 Expression operator*(double scalar, const Variable& v)
 {
-	auto e = Expression();
-	e.SetVariableCoefficient(v, scalar);
+	Expression e(v);
+	e *= scalar;
 	return e;
 }
 
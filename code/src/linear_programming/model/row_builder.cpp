@@ -0,0 +1,94 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/model/row_builder.h"
+
+using namespace std;
+
+namespace goc
+{
+RowBuilder::RowBuilder() : open_row_begin_(0)
+{ }
+
+void RowBuilder::Reserve(int row_count, int nonzero_count)
+{
+	row_begin_.reserve(row_count);
+	right_sides_.reserve(row_count);
+	senses_.reserve(row_count);
+	column_indices_.reserve(nonzero_count);
+	values_.reserve(nonzero_count);
+}
+
+RowBuilder& RowBuilder::AddTerm(const Variable& variable, double coefficient)
+{
+	column_indices_.push_back(variable.Index());
+	values_.push_back(coefficient);
+	return *this;
+}
+
+RowBuilder& RowBuilder::EndRow(enum Constraint::Sense sense, double right_side)
+{
+	row_begin_.push_back(open_row_begin_);
+	open_row_begin_ = values_.size();
+	senses_.push_back(sense);
+	right_sides_.push_back(right_side);
+	return *this;
+}
+
+RowBuilder& RowBuilder::AddRow(const Constraint& constraint)
+{
+	const vector<Variable>& variables = constraint.LeftSide().Variables();
+	const vector<double>& coefficients = constraint.LeftSide().Coefficients();
+	for (const Variable& variable: variables) column_indices_.push_back(variable.Index());
+	values_.insert(values_.end(), coefficients.begin(), coefficients.end());
+	return EndRow(constraint.Sense(), constraint.RightSide());
+}
+
+void RowBuilder::Clear()
+{
+	row_begin_.clear();
+	column_indices_.clear();
+	values_.clear();
+	right_sides_.clear();
+	senses_.clear();
+	open_row_begin_ = 0;
+}
+
+int RowBuilder::RowCount() const
+{
+	return right_sides_.size();
+}
+
+int RowBuilder::NonZeroCount() const
+{
+	return open_row_begin_;
+}
+
+const vector<int>& RowBuilder::RowBegin() const
+{
+	return row_begin_;
+}
+
+const vector<int>& RowBuilder::ColumnIndices() const
+{
+	return column_indices_;
+}
+
+const vector<double>& RowBuilder::Values() const
+{
+	return values_;
+}
+
+const vector<double>& RowBuilder::RightSides() const
+{
+	return right_sides_;
+}
+
+const vector<enum Constraint::Sense>& RowBuilder::Senses() const
+{
+	return senses_;
+}
+} // namespace goc
@@ -10,35 +10,46 @@ using namespace std;
 
 namespace goc
 {
-Variable::Variable() : index_(nullptr)
+namespace
+{
+// Name of the variables that do not belong to a formulation.
+const string EMPTY_NAME = "";
+}
+
+Variable::Variable() : entry_(nullptr)
 { }
 
 int Variable::Index() const
 {
-	return index_ == nullptr ? -1 : *index_;
+	return entry_ == nullptr ? -1 : entry_->index;
 }
 
-void Variable::Print(ostream& os) const
+const string& Variable::Name() const
 {
-	os << name;
+	return entry_ == nullptr ? EMPTY_NAME : entry_->name;
 }
 
 bool Variable::operator<(const Variable& v) const
 {
-	return index_ < v.index_;
+	return entry_ < v.entry_;
 }
 
 bool Variable::operator==(const Variable& v) const
 {
-	return v.index_ == index_;
+	return v.entry_ == entry_;
 }
 
 bool Variable::operator!=(const Variable& v) const
 {
-	return v.index_ != index_;
+	return v.entry_ != entry_;
 }
 
-Variable::Variable(const string& name, int* index)
-	: name(name), index_(index)
+Variable::Variable(VariableEntry* entry)
+	: entry_(entry)
 { }
-} // namespace goc
\ No newline at end of file
+
+ostream& operator<<(ostream& os, const Variable& v)
+{
+	return os << v.Name();
+}
+} // namespace goc
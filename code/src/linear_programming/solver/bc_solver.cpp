@@ -6,6 +6,8 @@
 
 #include "goc/linear_programming/solver/bc_solver.h"
 
+#include <memory>
+
 #include "goc/linear_programming/cplex/cplex_formulation.h"
 #include "goc/linear_programming/cplex/cplex_solver.h"
 #include "goc/time/duration.h"
@@ -18,16 +20,37 @@ namespace goc
 BCSolver::BCSolver()
 {
 	time_limit = Duration::Max();
-	config = {};
+	config_ = {};
 	screen_output = nullptr;
 }
 
 BCExecutionLog BCSolver::Solve(Formulation* formulation, const std::unordered_set<BCOption>& options) const
 {
-	return cplex::solve_bc((CplexFormulation*)formulation, screen_output, time_limit, config, initial_solutions,
+	auto cplex_formulation = (CplexFormulation*)formulation;
+	
+	// Compile the configuration only in the first solve after it is set. If many threads compile it at the same
+	// time they all get the same parameters, so any of them can be kept.
+	auto compiled_config = atomic_load(&compiled_config_);
+	if (!compiled_config)
+	{
+		compiled_config = make_shared<CplexConfiguration>(cplex_formulation->Environment(), config_);
+		atomic_store(&compiled_config_, compiled_config);
+	}
+	return cplex::solve_bc(cplex_formulation, screen_output, time_limit, *compiled_config, initial_solutions,
 						  branch_priorities, separation_strategy, options);
 }
 
+void BCSolver::SetConfig(const json& config)
+{
+	config_ = config;
+	atomic_store(&compiled_config_, shared_ptr<CplexConfiguration>());
+}
+
+const json& BCSolver::Config() const
+{
+	return config_;
+}
+
 Formulation* BCSolver::NewFormulation()
 {
 	return new CplexFormulation();
@@ -0,0 +1,35 @@
+//
+// Created by Gonzalo Lera Romero.
+// Grupo de Optimizacion Combinatoria (GOC).
+// Departamento de Computacion - Universidad de Buenos Aires.
+//
+
+#include "goc/linear_programming/solver/bcp_solver.h"
+
+#include "goc/linear_programming/bcp/bcp.h"
+#include "goc/time/duration.h"
+
+using namespace std;
+
+namespace goc
+{
+BCPSolver::BCPSolver()
+{
+	screen_output = nullptr;
+	time_limit = Duration::Max();
+	artificial_cost = 1e6;
+	thread_count = 1;
+	deterministic = false;
+}
+
+BCPExecutionLog BCPSolver::Solve(Formulation* formulation, const unordered_set<BCOption>& options) const
+{
+	return solve_bcp(formulation, screen_output, time_limit, cg_solver, separation_strategy, branching_rule,
+		node_pricing, artificial_cost, thread_count, deterministic, options);
+}
+
+Formulation* BCPSolver::NewFormulation()
+{
+	return CGSolver::NewFormulation();
+}
+} // namespace goc
@@ -9,6 +9,7 @@
 #include "goc/linear_programming/colgen/colgen.h"
 #include "goc/linear_programming/cplex/cplex_formulation.h"
 #include "goc/linear_programming/cplex/cplex_solver.h"
+#include "goc/math/number_utils.h"
 #include "goc/time/duration.h"
 
 using namespace std;
@@ -21,17 +22,37 @@ namespace
 LPSolver default_lp_solver;
 }
 
+PricingResult::PricingResult() : formulation_changed(false), exact(false), best_reduced_cost(0.0)
+{ }
+
+bool PricingResult::MasterChanged() const
+{
+	return formulation_changed || columns.ColumnCount() > 0;
+}
+
 CGSolver::CGSolver()
 {
 	// Set default values.
 	time_limit = Duration::Max();
 	lp_solver = &default_lp_solver;
 	screen_output = nullptr;
+	smoothing_alpha = 0.0;
+	automatic_smoothing = false;
+	convexity_bound = 0.0;
+	gap_limit = 0.0;
+	cutoff = INFTY;
+	column_age_limit = 0;
+	pool_extract_limit = INT_MAX;
+	pricing_thread_count = 1;
 }
 
 CGExecutionLog CGSolver::Solve(Formulation* formulation, const std::unordered_set<CGOption>& options) const
 {
-	return solve_colgen(formulation, screen_output, time_limit, pricing_function, lp_solver, options);
+	vector<PricingOracle> oracles = pricing_oracles;
+	if (oracles.empty()) oracles.push_back({"pricing", 0, pricing_function, 0.0});
+	return solve_colgen(formulation, screen_output, time_limit, oracles, pricing_thread_count, lp_solver,
+		smoothing_alpha, automatic_smoothing, convexity_bound, gap_limit, cutoff, column_age_limit, pool_extract_limit,
+		options);
 }
 
 Formulation* CGSolver::NewFormulation()
@@ -6,6 +6,8 @@
 
 #include "goc/linear_programming/solver/lp_solver.h"
 
+#include <memory>
+
 #include "goc/linear_programming/cplex/cplex_formulation.h"
 #include "goc/linear_programming/cplex/cplex_solver.h"
 
@@ -18,13 +20,34 @@ LPSolver::LPSolver()
 {
 	// Set default values.
 	time_limit = Duration::Max();
-	config = {};
+	config_ = {};
 	screen_output = nullptr;
 }
 
 LPExecutionLog LPSolver::Solve(Formulation* formulation, const unordered_set<LPOption>& options) const
 {
-	return cplex::solve_lp((CplexFormulation*)formulation, screen_output, time_limit, config, options);
+	auto cplex_formulation = (CplexFormulation*)formulation;
+	
+	// Compile the configuration only in the first solve after it is set. If many threads compile it at the same
+	// time they all get the same parameters, so any of them can be kept.
+	auto compiled_config = atomic_load(&compiled_config_);
+	if (!compiled_config)
+	{
+		compiled_config = make_shared<CplexConfiguration>(cplex_formulation->Environment(), config_);
+		atomic_store(&compiled_config_, compiled_config);
+	}
+	return cplex::solve_lp(cplex_formulation, screen_output, time_limit, *compiled_config, options);
+}
+
+void LPSolver::SetConfig(const json& config)
+{
+	config_ = config;
+	atomic_store(&compiled_config_, shared_ptr<CplexConfiguration>());
+}
+
+const json& LPSolver::Config() const
+{
+	return config_;
 }
 
 Formulation* LPSolver::NewFormulation()
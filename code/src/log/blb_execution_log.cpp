@@ -40,6 +40,7 @@ ostream& operator<<(ostream& os, BLBStatus status)
 {
 	unordered_map<BLBStatus, string> mapper = {{BLBStatus::DidNotStart, "DidNotStart"},
 											   {BLBStatus::TimeLimitReached, "TimeLimitReached"},
+											   {BLBStatus::ProcessLimitReached, "ProcessLimitReached"},
 											   {BLBStatus::SolutionLimitReached, "SolutionLimitReached"},
 											   {BLBStatus::Finished, "Finished"}};
 	return os << mapper[status];
@@ -6,6 +6,7 @@
 
 #include "goc/log/cg_execution_log.h"
 
+#include "goc/math/number_utils.h"
 #include "goc/string/string_utils.h"
 
 using namespace std;
@@ -19,7 +20,8 @@ CGExecutionLog::CGExecutionLog()
 	time = 0.0_sec;
 	status = CGStatus::DidNotStart;
 	incumbent_value = 0.0;
-	columns_added = iteration_count = 0;
+	lagrangian_bound = -INFTY;
+	columns_added = columns_removed = columns_from_pool = iteration_count = smoothed_pricing_count = mispricing_count = 0;
 	pricing_time = lp_time = 0.0_sec;
 }
 
@@ -33,10 +35,18 @@ json CGExecutionLog::ToJSON() const
 	j["incumbent"] = incumbent;
 	j["incumbent_value"] = incumbent_value;
 	j["columns_added"] = columns_added;
+	j["columns_removed"] = columns_removed;
+	j["columns_from_pool"] = columns_from_pool;
+	j["lagrangian_bound"] = lagrangian_bound;
+	j["bound_trajectory"] = bound_trajectory;
 	j["iteration_count"] = iteration_count;
+	j["smoothed_pricing_count"] = smoothed_pricing_count;
+	j["mispricing_count"] = mispricing_count;
 	j["pricing_time"] = pricing_time;
 	j["lp_time"] = lp_time;
 	j["iterations"] = iterations;
+	j["oracle_time"] = oracle_time;
+	j["oracle_column_count"] = oracle_column_count;
 	
 	return j;
 }
@@ -48,7 +58,9 @@ ostream& operator<<(ostream& os, CGStatus status)
 											  {CGStatus::Unbounded, "Unbounded"},
 											  {CGStatus::TimeLimitReached, "TimeLimitReached"},
 											  {CGStatus::MemoryLimitReached, "MemoryLimitReached"},
-											  {CGStatus::Optimum, "Optimum"}};
+											  {CGStatus::Optimum, "Optimum"},
+											  {CGStatus::GapLimitReached, "GapLimitReached"},
+											  {CGStatus::CutoffReached, "CutoffReached"}};
 	return os << mapper[status];
 }
 } // namespace goc
\ No newline at end of file
@@ -38,6 +38,7 @@ json LPExecutionLog::ToJSON() const
 	j["constraint_count"] = constraint_count;
 	j["variable_count"] = variable_count;
 	j["duals"] = duals;
+	j["reduced_costs"] = reduced_costs;
 	return j;
 }
 
@@ -14,7 +14,7 @@ using namespace goc;
 
 // Define the bitset of vertices with N=maximum number of vertices.
 #define MAX_N 11
-typedef bitset<MAX_N> VertexSet;
+typedef bitset<MAX_N> IndependentSet;
 
 // Solves a maximum weight independent set problem.
 //	n: number of vertices in the graph.
@@ -23,7 +23,7 @@ typedef bitset<MAX_N> VertexSet;
 //	W: output parameter with the solution value.
 //	S: output parameter with the solution.
 // Returns: the execution log.
-BCExecutionLog maximum_weight_independent_set(const Graph& G, const vector<double>& w, double* W, VertexSet* S)
+BCExecutionLog maximum_weight_independent_set(const Graph& G, const vector<double>& w, double* W, IndependentSet* S)
 {
 	// Create formulation:
 	// max w[i] x[i]
@@ -61,19 +61,17 @@ void init_set_partitioning_formulation(int n, Formulation* rmp)
 	for (int i = 0; i < n; ++i) rmp->AddConstraint(Expression().EQ(1.0));
 }
 
-// Adds the independent set S to the rmp.
+// Adds the column of the independent set S to the block of columns.
 // n: number of vertices in the graph.
-// rmp: restricted master problem.
 // S: set to add to the formulation.
-// y: vector of set variables.
-// I: vector of independent sets associated with variables y.
-void add_independent_set(int n, Formulation* rmp, const VertexSet& S, vector<Variable>* y, vector<VertexSet>* I)
+// columns: block of columns where the set is added.
+// I: vector of independent sets associated with the set variables (I[j] is the set of variable y_j).
+void add_independent_set(int n, const IndependentSet& S, ColumnBuilder* columns, vector<IndependentSet>* I)
 {
-	int j = y->size();
+	int j = I->size();
 	I->push_back(S);
-	y->push_back(rmp->AddVariable("y_" + STR(j), VariableDomain::Real, 0.0, INFTY));
-	rmp->SetObjectiveCoefficient((*y)[j], 1.0);
-	for (int i = 0; i < n; ++i) if (S.test(i)) rmp->SetConstraintCoefficient(i, (*y)[j], 1.0);
+	for (int i = 0; i < n; ++i) if (S.test(i)) columns->AddTerm(i, 1.0);
+	columns->EndColumn("y_" + STR(j), 1.0, VariableDomain::Real, 0.0, INFTY);
 }
 
 // In this example we get an upper bound on the Vertex-Coloring Problem using column generation.
@@ -102,23 +100,29 @@ int main()
 	
 	// Create formulation.
 	Formulation* rmp = LPSolver::NewFormulation();
-	vector<Variable> y;
-	vector<VertexSet> I;
+	vector<IndependentSet> I;
 	init_set_partitioning_formulation(n, rmp);
-	for (int i = 0; i < n; ++i) add_independent_set(n, rmp, create_bitset<MAX_N>({i}), &y, &I); // Add the trivial independent sets.
+	ColumnBuilder trivial_sets;
+	for (int i = 0; i < n; ++i) add_independent_set(n, create_bitset<MAX_N>({i}), &trivial_sets, &I);
+	rmp->AddColumns(trivial_sets);
 	CGSolver cg_solver;
 	LPSolver lp_solver;
 	cg_solver.time_limit = 2.0_hr;
 	cg_solver.screen_output = &clog;
 	cg_solver.lp_solver = &lp_solver;
+	cg_solver.convexity_bound = n; // at most n colors are used.
 	cg_solver.pricing_function = [&] (const vector<double>& duals, double incumbent_value, Duration time_limit,
 									  CGExecutionLog* execution_log) {
-		// Solve a maximum weight independent set problem.
+		// Solve a maximum weight independent set problem, the reduced cost of the set S is 1 - W.
 		double W;
-		VertexSet S;
+		IndependentSet S;
 		auto pricing_log = maximum_weight_independent_set(G, duals, &W, &S);
-		if (epsilon_bigger(W, 1.0)) add_independent_set(n, rmp, S, &y, &I);
-		execution_log->iterations->push_back(pricing_log);
+		PricingResult result;
+		result.exact = true;
+		result.best_reduced_cost = 1.0 - W;
+		if (epsilon_bigger(W, 1.0)) add_independent_set(n, S, &result.columns, &I);
+		execution_log->iterations.push_back(pricing_log);
+		return result;
 	};
 	
 	clog << "Restricted Master Problem" << endl;
@@ -132,9 +136,9 @@ int main()
 	if (execution_log.status == CGStatus::Optimum)
 	{
 		clog << "Best bound: " << execution_log.incumbent_value << endl;
-		for (int i = 0; i < y.size(); ++i)
-			if (epsilon_bigger(execution_log.incumbent->at(y[i]), 0.0))
-				clog << I[i] << ": " << execution_log.incumbent->at(y[i]) << endl;
+		for (int i = 0; i < I.size(); ++i)
+			if (epsilon_bigger(execution_log.incumbent.at(rmp->VariableAtIndex(i)), 0.0))
+				clog << I[i] << ": " << execution_log.incumbent.at(rmp->VariableAtIndex(i)) << endl;
 				
 	}
 	return 0;
@@ -102,7 +102,7 @@ int main()
 	BCSolver solver;
 	solver.time_limit = 2.0_hr;
 	solver.screen_output = &clog;
-	solver.config = {{"CPX_PARAM_CUTSFACTOR", 0}}; // Disable CPLEX cuts.
+	solver.SetConfig({{"CPX_PARAM_CUTSFACTOR", 0}}); // Disable CPLEX cuts.
 	
 	// Add cut families to the cut strategy.
 	OddHoleSeparation odd_hole_separation(G, x);
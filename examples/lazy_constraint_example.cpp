@@ -34,6 +34,12 @@ public:
 		: G(G), x(x)
 	{ }
 	
+	// Separate only reads the graph and the variables, so many CPLEX threads can call it at the same time.
+	virtual Concurrency ConcurrencySupport() const
+	{
+		return Concurrency::Stateless;
+	}
+	
 	virtual vector<Constraint> Separate(const Valuation& x_star, int node_number, int count_limit,
 		double node_bound) const
 	{